@@ -0,0 +1,86 @@
+#pragma once
+
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/depthaiUtility.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/msg/april_tag_detection_array.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <depthai_ros_msgs/AprilTagDetectionArray.h>
+    #include <ros/ros.h>
+
+    #include <boost/make_shared.hpp>
+#endif
+
+struct apriltag_detector;
+struct apriltag_family;
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiMsgs = depthai_ros_msgs::msg;
+using AprilTagDetectionArrayPtr = DepthaiMsgs::AprilTagDetectionArray::SharedPtr;
+#else
+namespace DepthaiMsgs = depthai_ros_msgs;
+using AprilTagDetectionArrayPtr = DepthaiMsgs::AprilTagDetectionArray::Ptr;
+#endif
+
+/**
+ * Detects AprilTags on the luma plane of an ImgFrame and estimates their poses. The detector reads the device buffer in
+ * place, so no ROS image is built for it; meant for BridgePublisher::addSidePublisher(), which only runs it while the
+ * tag topic has subscribers. Luma is the Y plane of NV12/YUV420p and the image of GRAY8/RAW8, other types get an
+ * empty array. Poses are estimated from the corners undistorted with the camera info's distortion, so unrectified
+ * frames of wide field of view modules need no rectification pass. Only available when the bridge was built with
+ * apriltag (DEPTHAI_BRIDGE_HAS_APRILTAG).
+ */
+class AprilTagConverter {
+   public:
+    /**
+     * @param cameraInfo Intrinsics and distortion of the frames, e.g. from ImageConverter::calibrationToCameraInfo().
+     * Rescaled when the frames are sized differently. Supports the plumb_bob, rational_polynomial and equidistant models,
+     * throws for other models with non zero coefficients; use the camera info of the rectified stream for rectified frames.
+     * @param tagSize Edge length of the tags' black square in meters.
+     * @param family One of tag36h11, tag25h9, tag16h5 and tagStandard41h12.
+     * @param quadDecimate Quad search runs on the image decimated by this factor, the corners are then refined on the full
+     * image. Trades range for speed.
+     * @param threads Worker threads of the detector.
+     */
+    AprilTagConverter(const std::string frameName,
+                      const ImageMsgs::CameraInfo& cameraInfo,
+                      double tagSize,
+                      const std::string& family = "tag36h11",
+                      float quadDecimate = 2.0f,
+                      int threads = 2);
+    ~AprilTagConverter();
+
+    AprilTagConverter(const AprilTagConverter&) = delete;
+    AprilTagConverter& operator=(const AprilTagConverter&) = delete;
+
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::AprilTagDetectionArray& outTagsMsg);
+    AprilTagDetectionArrayPtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
+
+   private:
+    const std::string _frameName;
+    const std::string _familyName;
+    const double _tagSize;
+    const double _fx, _fy, _cx, _cy;
+    const int _width, _height;
+    // Empty when the frames are not distorted
+    std::vector<double> _distortion;
+    bool _fisheye = false;
+    apriltag_family* _family = nullptr;
+    void (*_familyDestroy)(apriltag_family*) = nullptr;
+    apriltag_detector* _detector = nullptr;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <depthai_bridge/CameraControlBridge.hpp>
+
+#include "depthai/depthai.hpp"
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Host side auto exposure. Computes a decimated luminance histogram of every NV12/YUV420p/GRAY8/RAW8 frame it is fed
+ * (e.g. as a BridgePublisher frame observer) and drives exposure time and ISO through a CameraControlBridge.
+ */
+class AutoExposureController {
+   public:
+    struct Config {
+        // Mean luma the controller steers to (0..255)
+        float targetLuma = 110;
+        // Fraction of the log exposure error corrected per update, lower is smoother
+        float gain = 0.6f;
+        // Relative luma error tolerated without sending a new exposure
+        float deadband = 0.08f;
+        // Exposure time is raised up to maxExposureUs before ISO is raised above minIso
+        uint32_t minExposureUs = 20, maxExposureUs = 33000;
+        uint32_t minIso = 100, maxIso = 1600;
+        // Only every decimation-th pixel of every decimation-th row is sampled
+        int decimation = 4;
+        // Frames waited for a new exposure to take effect before correcting again
+        int settleFrames = 3;
+    };
+
+    AutoExposureController(std::shared_ptr<CameraControlBridge> controlBridge, Config config);
+
+    void processFrame(std::shared_ptr<dai::ImgFrame> inData);
+
+    const std::array<uint32_t, 256>& getHistogram() const;
+
+    static void computeHistogram(const uint8_t* luma, int width, int height, int stride, int decimation, std::array<uint32_t, 256>& histogram);
+
+   private:
+    std::shared_ptr<CameraControlBridge> _controlBridge;
+    const Config _config;
+    std::array<uint32_t, 256> _histogram;
+    uint32_t _requestedExposureUs = 0, _requestedIso = 0;
+    int _framesSinceRequest = 0;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -1,5 +1,15 @@
 #pragma once
 
+#include <atomic>
+#include <depthai_bridge/HugePageBuffer.hpp>
+#include <depthai_bridge/LatencyBudget.hpp>
+#include <depthai_bridge/PublisherStats.hpp>
+#include <depthai_bridge/QueueTuner.hpp>
+#include <depthai_bridge/SharedStatsBlock.hpp>
+#include <depthai_bridge/ThreadOptions.hpp>
+#include <depthai_bridge/depthaiUtility.hpp>
+#include <future>
+#include <memory>
 #include <thread>
 #include <type_traits>
 #include <typeinfo>
@@ -13,6 +23,7 @@
     #include <camera_info_manager/camera_info_manager.hpp>
     #include <image_transport/image_transport.hpp>
 
+    #include "diagnostic_msgs/msg/diagnostic_array.hpp"
     #include "rclcpp/rclcpp.hpp"
     #include "sensor_msgs/msg/camera_info.hpp"
     #include "sensor_msgs/msg/image.hpp"
@@ -26,6 +37,7 @@
     #include <boost/make_shared.hpp>
     #include <boost/shared_ptr.hpp>
 
+    #include "diagnostic_msgs/DiagnosticArray.h"
     #include "sensor_msgs/Image.h"
 #endif
 
@@ -36,19 +48,53 @@ namespace ros {
 #ifdef IS_ROS2
 namespace StdMsgs = std_msgs::msg;
 namespace ImageMsgs = sensor_msgs::msg;
+namespace DiagnosticMsgs = diagnostic_msgs::msg;
 using ImagePtr = ImageMsgs::Image::SharedPtr;
 namespace rosOrigin = ::rclcpp;
 #else
 namespace StdMsgs = std_msgs;
 namespace ImageMsgs = sensor_msgs;
+namespace DiagnosticMsgs = diagnostic_msgs;
 using ImagePtr = ImageMsgs::ImagePtr;
 namespace rosOrigin = ::ros;
 #endif
 
+namespace detail {
+
+// Scales the intrinsics of the camera info to the size of the published image, which the converter may have downscaled
+inline void matchCameraInfo(const ImageMsgs::Image& image, ImageMsgs::CameraInfo& cameraInfo) {
+    if(cameraInfo.width == 0 || cameraInfo.height == 0 || (image.width == cameraInfo.width && image.height == cameraInfo.height)) return;
+    const double scaleX = static_cast<double>(image.width) / cameraInfo.width, scaleY = static_cast<double>(image.height) / cameraInfo.height;
+#ifdef IS_ROS2
+    auto& k = cameraInfo.k;
+    auto& p = cameraInfo.p;
+#else
+    auto& k = cameraInfo.K;
+    auto& p = cameraInfo.P;
+#endif
+    for(int i = 0; i < 3; ++i) {
+        k[i] *= scaleX;
+        k[3 + i] *= scaleY;
+    }
+    for(int i = 0; i < 4; ++i) {
+        p[i] *= scaleX;
+        p[4 + i] *= scaleY;
+    }
+    cameraInfo.width = image.width;
+    cameraInfo.height = image.height;
+}
+
+template <class Msg>
+void matchCameraInfo(const Msg&, ImageMsgs::CameraInfo&) {}
+
+}  // namespace detail
+
 template <class RosMsg, class SimMsg>
 class BridgePublisher {
    public:
     using ConvertFunc = std::function<void(std::shared_ptr<SimMsg>, RosMsg&)>;
+    using FrameObserver = std::function<void(std::shared_ptr<SimMsg>)>;
+    using PublishFilter = std::function<bool(std::shared_ptr<SimMsg>)>;
 
 #ifdef IS_ROS2
     using CustomPublisher = typename std::conditional<std::is_same<RosMsg, ImageMsgs::Image>::value,
@@ -86,6 +132,12 @@ class BridgePublisher {
      * Tag Dispacher function to to overload the Publisher to use Default ros::Publisher
      */
     typename rclcpp::Publisher<RosMsg>::SharedPtr advertise(int queueSize, std::false_type);
+
+    /**
+     * Same as above for another topic, without camera info
+     */
+    std::shared_ptr<image_transport::Publisher> advertise(const std::string& rosTopic, int queueSize, std::true_type);
+    typename rclcpp::Publisher<RosMsg>::SharedPtr advertise(const std::string& rosTopic, int queueSize, std::false_type);
 #else
     using CustomPublisher = typename std::
         conditional<std::is_same<RosMsg, ImageMsgs::Image>::value, std::shared_ptr<image_transport::Publisher>, std::shared_ptr<rosOrigin::Publisher> >::type;
@@ -116,6 +168,12 @@ class BridgePublisher {
      */
     std::shared_ptr<rosOrigin::Publisher> advertise(int queueSize, std::false_type);
 
+    /**
+     * Same as above for another topic, without camera info
+     */
+    std::shared_ptr<image_transport::Publisher> advertise(const std::string& rosTopic, int queueSize, std::true_type);
+    std::shared_ptr<rosOrigin::Publisher> advertise(const std::string& rosTopic, int queueSize, std::false_type);
+
 #endif
 
     BridgePublisher(const BridgePublisher& other);
@@ -126,17 +184,117 @@ class BridgePublisher {
 
     void publishHelper(std::shared_ptr<SimMsg> inData);
 
+    /**
+     * Observers see every message taken from the queue, before and regardless of the subscriber check of the main topic.
+     * They run on the publishing thread so they have to be cheap. Add them before starting the thread or callback.
+     */
+    void addFrameObserver(FrameObserver observer);
+
+    /**
+     * Publishes a second, usually small, message converted from every incoming message on its own topic,
+     * independent of whether the main topic has subscribers. e.g. CameraMetadataConverter next to an image stream.
+     * The side message gets exactly the header stamp of the main message, so ExactTime synchronizers can pair them.
+     */
+    template <class SideMsg>
+    void addSidePublisher(std::string rosTopic, std::function<void(std::shared_ptr<SimMsg>, SideMsg&)> converter, int queueSize = 10);
+
+    /**
+     * A message is only converted and published when every filter returns true for it, e.g. SceneChangeDetector.
+     * Filters run after the frame observers, on the raw depthai message. Add them before starting the thread or callback.
+     */
+    void addPublishFilter(PublishFilter filter);
+
+    /**
+     * Scheduling priority, CPU affinity and memory locking of the reading thread, call before startPublisherThread().
+     * Does not apply to addPublisherCallback(), which runs on the depthai callback thread.
+     */
+    void setThreadOptions(const ThreadOptions& options);
+
+    /**
+     * Converts every message into the same message object instead of a fresh one, so a multi megabyte pixel buffer
+     * (Image, PointCloud2, DisparityImage) is allocated once, from huge page advised memory, and not page faulted in
+     * again for every frame. Off by default; the converter has to overwrite the whole message, as the bridge's image,
+     * disparity and point cloud converters do.
+     */
+    void setReuseMessageBuffers(bool reuse);
+
+    /**
+     * Message counts since construction, safe to call from any thread.
+     */
+    PublisherStats getStats() const;
+
+    /**
+     * Publishes the stats on /diagnostics every period, with a warning level whenever frames were lost since the
+     * previous report. Needs a spinning node (ROS2) or node handle (ROS1) for the timer.
+     */
+    void enableDiagnostics(std::chrono::milliseconds period = std::chrono::milliseconds(1000));
+
+    /**
+     * Moves the stream's counters, conversion time and latency histograms into a record of the shared memory block,
+     * where bridge_top reads them. Call before starting the thread or callback, earlier counts are not carried over.
+     */
+    void exportStats(std::shared_ptr<SharedStatsBlock> statsBlock);
+
+    /**
+     * Lets the reading thread resize the host queue and switch it to non blocking so that messages wait in it no
+     * longer than targetWait, see QueueTuner. The queue never grows beyond the size it has when this is called.
+     * Call before startPublisherThread(), has no effect with addPublisherCallback().
+     */
+    void setQueueLatencyTarget(std::chrono::milliseconds targetWait);
+
+    /**
+     * Feeds the latency of every published message to the budget and drops the frames it asks to skip, counting them
+     * as filtered. Further degradation is applied through the budget's level callback. Every received message updates
+     * the budget, so it also recovers while nothing is published.
+     */
+    void setLatencyBudget(std::shared_ptr<LatencyBudget> latencyBudget);
+
+    /**
+     * Also publishes the stream on rosTopic at no more than rateHz, e.g. 2 Hz images for a dashboard next to the full
+     * rate topic, instead of a throttle node receiving every frame. Frames are paced by their device timestamps and only
+     * converted when a topic with subscribers is due, once for all the topics publishing them. No camera info is
+     * published for tiers. Throws for a rate that is not positive. Add tiers before starting the thread or callback.
+     */
+    void addRateTier(std::string rosTopic, double rateHz, int queueSize = 10);
+
+    /**
+     * Starts the reading thread. Throws if the thread options set with setThreadOptions() can not be applied.
+     */
     void startPublisherThread();
 
     ~BridgePublisher();
 
    private:
+    struct RateTier {
+        std::string rosTopic;
+        CustomPublisher publisher;
+        std::chrono::steady_clock::duration period;
+        std::chrono::steady_clock::time_point nextDue;
+    };
+
     /**
      * adding this callback will allow you to still be able to consume
      * the data for other processing using get() function .
      */
     void daiCallback(std::string name, std::shared_ptr<ADatatype> data);
 
+    /**
+     * Extra callback on the queue in thread mode, sees every message the host queue receives so that
+     * overflow of the queue can be told apart from loss before the host.
+     */
+    void arrivalCallback(std::string name, std::shared_ptr<ADatatype> data);
+
+    void publishDiagnostics();
+
+    /**
+     * Records queue wait and depth of a message the reading thread took from the queue and feeds the tuner.
+     * arrivedAtDequeue is the arrival count when it was taken, publishHelper() has accounted the message since.
+     */
+    void sampleQueue(std::shared_ptr<SimMsg> inDataPtr, std::chrono::steady_clock::time_point dequeued, uint64_t arrivedAtDequeue);
+
+    // Publishes the camera info matching the converted message, scaled to its size if the converter downscaled it
+    void publishCameraInfo(const RosMsg& opMsg, const std::string& frameId);
+
     static const std::string LOG_TAG;
     std::shared_ptr<dai::DataOutputQueue> _daiMessageQueue;
     ConvertFunc _converter;
@@ -158,6 +316,36 @@ class BridgePublisher {
     std::unique_ptr<camera_info_manager::CameraInfoManager> _camInfoManager;
     bool _isCallbackAdded = false;
     bool _isImageMessage = false;  // used to enable camera info manager
+    std::vector<FrameObserver> _frameObservers;
+    std::vector<PublishFilter> _publishFilters;
+    ThreadOptions _threadOptions;
+    bool _reuseMessageBuffers = false;
+    RosMsg _reusedMsg;
+    size_t _hugePageBytes = 0;
+
+    int _arrivalCallbackId = -1;
+    SequenceTracker _arrivalSequence, _receivedSequence;
+    StreamStatsRecord _localStats;
+    StreamStatsRecord* _stats = &_localStats;
+    std::shared_ptr<SharedStatsBlock> _statsBlock;
+    uint64_t _lastReportedLost = 0;
+    LatencyHistogram::Counts _lastReportedQueueWait{};
+    std::unique_ptr<QueueTuner> _queueTuner;
+    std::shared_ptr<LatencyBudget> _latencyBudget;
+    std::vector<RateTier> _rateTiers;
+    std::vector<size_t> _dueTiers;
+    // ROS stamp of the message being published, computed once so that the main and side messages share it
+    rosOrigin::Time _frameStamp;
+    bool _hasFrameStamp = false;
+    unsigned _queueMaxSize = 0;
+    bool _queueBlocking = true;
+#ifdef IS_ROS2
+    rclcpp::Publisher<DiagnosticMsgs::DiagnosticArray>::SharedPtr _diagnosticsPublisher;
+    rclcpp::TimerBase::SharedPtr _diagnosticsTimer;
+#else
+    std::shared_ptr<rosOrigin::Publisher> _diagnosticsPublisher;
+    rosOrigin::WallTimer _diagnosticsTimer;
+#endif
 };
 
 template <class RosMsg, class SimMsg>
@@ -212,7 +400,17 @@ BridgePublisher<RosMsg, SimMsg>::BridgePublisher(std::shared_ptr<dai::DataOutput
 
 template <class RosMsg, class SimMsg>
 typename rclcpp::Publisher<RosMsg>::SharedPtr BridgePublisher<RosMsg, SimMsg>::advertise(int queueSize, std::false_type) {
-    return _node->create_publisher<RosMsg>(_rosTopic, queueSize);
+    return advertise(_rosTopic, queueSize, std::false_type{});
+}
+
+template <class RosMsg, class SimMsg>
+typename rclcpp::Publisher<RosMsg>::SharedPtr BridgePublisher<RosMsg, SimMsg>::advertise(const std::string& rosTopic, int queueSize, std::false_type) {
+    return _node->create_publisher<RosMsg>(rosTopic, queueSize);
+}
+
+template <class RosMsg, class SimMsg>
+std::shared_ptr<image_transport::Publisher> BridgePublisher<RosMsg, SimMsg>::advertise(const std::string& rosTopic, int queueSize, std::true_type) {
+    return std::make_shared<image_transport::Publisher>(_it.advertise(rosTopic, queueSize));
 }
 
 template <class RosMsg, class SimMsg>
@@ -226,7 +424,7 @@ std::shared_ptr<image_transport::Publisher> BridgePublisher<RosMsg, SimMsg>::adv
         // _rosPublisher = _it.advertise(rosTopic, queueSize);
         _cameraInfoPublisher = _node->create_publisher<ImageMsgs::CameraInfo>(_cameraName + "/camera_info", queueSize);
     }
-    return std::make_shared<image_transport::Publisher>(_it.advertise(_rosTopic, queueSize));
+    return advertise(_rosTopic, queueSize, std::true_type{});
 }
 
 #else
@@ -270,7 +468,17 @@ BridgePublisher<RosMsg, SimMsg>::BridgePublisher(std::shared_ptr<dai::DataOutput
 
 template <class RosMsg, class SimMsg>
 std::shared_ptr<rosOrigin::Publisher> BridgePublisher<RosMsg, SimMsg>::advertise(int queueSize, std::false_type) {
-    return std::make_shared<rosOrigin::Publisher>(_nh.advertise<RosMsg>(_rosTopic, queueSize));
+    return advertise(_rosTopic, queueSize, std::false_type{});
+}
+
+template <class RosMsg, class SimMsg>
+std::shared_ptr<rosOrigin::Publisher> BridgePublisher<RosMsg, SimMsg>::advertise(const std::string& rosTopic, int queueSize, std::false_type) {
+    return std::make_shared<rosOrigin::Publisher>(_nh.advertise<RosMsg>(rosTopic, queueSize));
+}
+
+template <class RosMsg, class SimMsg>
+std::shared_ptr<image_transport::Publisher> BridgePublisher<RosMsg, SimMsg>::advertise(const std::string& rosTopic, int queueSize, std::true_type) {
+    return std::make_shared<image_transport::Publisher>(_it.advertise(rosTopic, queueSize));
 }
 
 template <class RosMsg, class SimMsg>
@@ -283,7 +491,7 @@ std::shared_ptr<image_transport::Publisher> BridgePublisher<RosMsg, SimMsg>::adv
         }
         _cameraInfoPublisher = std::make_shared<rosOrigin::Publisher>(_nh.advertise<ImageMsgs::CameraInfo>(_cameraName + "/camera_info", queueSize));
     }
-    return std::make_shared<image_transport::Publisher>(_it.advertise(_rosTopic, queueSize));
+    return advertise(_rosTopic, queueSize, std::true_type{});
 }
 
 template <class RosMsg, class SimMsg>
@@ -293,6 +501,12 @@ BridgePublisher<RosMsg, SimMsg>::BridgePublisher(const BridgePublisher& other) {
     _converter = other._converter;
     _rosTopic = other._rosTopic;
     _it = other._it;
+    _frameObservers = other._frameObservers;
+    _publishFilters = other._publishFilters;
+    _threadOptions = other._threadOptions;
+    _reuseMessageBuffers = other._reuseMessageBuffers;
+    _latencyBudget = other._latencyBudget;
+    _rateTiers = other._rateTiers;
     _rosPublisher = CustomPublisher(other._rosPublisher);
 
     if(other._isImageMessage) {
@@ -319,11 +533,33 @@ void BridgePublisher<RosMsg, SimMsg>::startPublisherThread() {
             "the thread using startPublisherThread() ");
     }
 
-    _readingThread = std::thread([&]() {
+    _arrivalCallbackId = _daiMessageQueue->addCallback(
+        std::bind(&BridgePublisher<RosMsg, SimMsg>::arrivalCallback, this, std::placeholders::_1, std::placeholders::_2));
+
+    // Shared with the thread, which may still be inside set_value() when get() below returns
+    auto optionsApplied = std::make_shared<std::promise<void>>();
+    auto optionsResult = optionsApplied->get_future();
+    _readingThread = std::thread([this, optionsApplied]() {
+        try {
+            applyThreadOptions(_threadOptions);
+            optionsApplied->set_value();
+        } catch(...) {
+            optionsApplied->set_exception(std::current_exception());
+            return;
+        }
+
+        // Polling with tryGet at SCHED_FIFO priority would starve everything else on the core, block instead
+        const bool blockingRead = _threadOptions.fifoPriority != 0;
         int messageCounter = 0;
         while(rosOrigin::ok()) {
             // auto daiDataPtr = _daiMessageQueue->get<SimMsg>();
-            auto daiDataPtr = _daiMessageQueue->tryGet<SimMsg>();
+            std::shared_ptr<SimMsg> daiDataPtr;
+            if(blockingRead) {
+                bool timedOut = false;
+                daiDataPtr = _daiMessageQueue->get<SimMsg>(std::chrono::milliseconds(100), timedOut);
+            } else {
+                daiDataPtr = _daiMessageQueue->tryGet<SimMsg>();
+            }
             if(daiDataPtr == nullptr) {
                 messageCounter++;
                 if(messageCounter > 2000000) {
@@ -337,9 +573,13 @@ void BridgePublisher<RosMsg, SimMsg>::startPublisherThread() {
             if(messageCounter != 0) {
                 messageCounter = 0;
             }
+            const auto dequeued = std::chrono::steady_clock::now();
+            const uint64_t arrivedAtDequeue = _stats->arrived;
             publishHelper(daiDataPtr);
+            sampleQueue(daiDataPtr, dequeued, arrivedAtDequeue);
         }
     });
+    optionsResult.get();
 }
 
 template <class RosMsg, class SimMsg>
@@ -354,9 +594,253 @@ void BridgePublisher<RosMsg, SimMsg>::addPublisherCallback() {
     _isCallbackAdded = true;
 }
 
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::addFrameObserver(FrameObserver observer) {
+    _frameObservers.push_back(observer);
+}
+
+template <class RosMsg, class SimMsg>
+template <class SideMsg>
+void BridgePublisher<RosMsg, SimMsg>::addSidePublisher(std::string rosTopic, std::function<void(std::shared_ptr<SimMsg>, SideMsg&)> converter, int queueSize) {
+#ifdef IS_ROS2
+    auto sidePublisher = _node->create_publisher<SideMsg>(rosTopic, queueSize);
+    addFrameObserver([this, sidePublisher, converter](std::shared_ptr<SimMsg> inDataPtr) {
+        if(sidePublisher->get_subscription_count() > 0) {
+            SideMsg sideMsg;
+            converter(inDataPtr, sideMsg);
+            if(_hasFrameStamp) sideMsg.header.stamp = _frameStamp;
+            sidePublisher->publish(sideMsg);
+        }
+    });
+#else
+    auto sidePublisher = std::make_shared<rosOrigin::Publisher>(_nh.advertise<SideMsg>(rosTopic, queueSize));
+    addFrameObserver([this, sidePublisher, converter](std::shared_ptr<SimMsg> inDataPtr) {
+        if(sidePublisher->getNumSubscribers() > 0) {
+            SideMsg sideMsg;
+            converter(inDataPtr, sideMsg);
+            if(_hasFrameStamp) sideMsg.header.stamp = _frameStamp;
+            sidePublisher->publish(sideMsg);
+        }
+    });
+#endif
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::addPublishFilter(PublishFilter filter) {
+    _publishFilters.push_back(filter);
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::setThreadOptions(const ThreadOptions& options) {
+    _threadOptions = options;
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::arrivalCallback(std::string name, std::shared_ptr<ADatatype> data) {
+    auto daiDataPtr = std::dynamic_pointer_cast<SimMsg>(data);
+    if(daiDataPtr == nullptr) return;
+    _stats->arrived++;
+    _stats->lostBeforeHost += _arrivalSequence.update(messageSequenceNum(*daiDataPtr));
+}
+
+template <class RosMsg, class SimMsg>
+PublisherStats BridgePublisher<RosMsg, SimMsg>::getStats() const {
+    PublisherStats stats;
+    stats.received = _stats->received;
+    stats.sequenceGaps = _stats->sequenceGaps;
+    stats.filtered = _stats->filtered;
+    stats.noSubscriber = _stats->noSubscriber;
+    stats.published = _stats->published;
+    const uint64_t missingAtReader = _stats->missingAtReader;
+    if(_arrivalCallbackId >= 0) {
+        stats.arrived = _stats->arrived;
+        stats.lostBeforeHost = _stats->lostBeforeHost;
+        // Whatever went missing between the host queue and the reader was discarded by the queue
+        stats.queueOverflow = missingAtReader > stats.lostBeforeHost ? missingAtReader - stats.lostBeforeHost : 0;
+    } else {
+        // With addPublisherCallback() the bridge sees messages as they arrive, there is no queue in between
+        stats.arrived = stats.received;
+        stats.lostBeforeHost = missingAtReader;
+    }
+    return stats;
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::enableDiagnostics(std::chrono::milliseconds period) {
+#ifdef IS_ROS2
+    _diagnosticsPublisher = _node->create_publisher<DiagnosticMsgs::DiagnosticArray>("/diagnostics", 10);
+    _diagnosticsTimer = _node->create_wall_timer(period, std::bind(&BridgePublisher<RosMsg, SimMsg>::publishDiagnostics, this));
+#else
+    _diagnosticsPublisher = std::make_shared<rosOrigin::Publisher>(_nh.advertise<DiagnosticMsgs::DiagnosticArray>("/diagnostics", 10));
+    _diagnosticsTimer = _nh.createWallTimer(rosOrigin::WallDuration(period.count() / 1000.0), [this](const rosOrigin::WallTimerEvent&) { publishDiagnostics(); });
+#endif
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::exportStats(std::shared_ptr<SharedStatsBlock> statsBlock) {
+    _stats = statsBlock->addStream(_rosTopic);
+    _statsBlock = statsBlock;
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::setQueueLatencyTarget(std::chrono::milliseconds targetWait) {
+    _queueMaxSize = _daiMessageQueue->getMaxSize();
+    _queueBlocking = _daiMessageQueue->getBlocking();
+    _queueTuner = std::make_unique<QueueTuner>(targetWait, _queueMaxSize);
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::setLatencyBudget(std::shared_ptr<LatencyBudget> latencyBudget) {
+    _latencyBudget = latencyBudget;
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::addRateTier(std::string rosTopic, double rateHz, int queueSize) {
+    if(rateHz <= 0) {
+        throw std::runtime_error("Rate of tier " + rosTopic + " has to be positive");
+    }
+    RateTier tier;
+    tier.rosTopic = rosTopic;
+    tier.publisher = advertise(rosTopic, queueSize, std::is_same<RosMsg, ImageMsgs::Image>{});
+    tier.period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / rateHz));
+    _rateTiers.push_back(tier);
+    _dueTiers.reserve(_rateTiers.size());
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::sampleQueue(std::shared_ptr<SimMsg> inDataPtr, std::chrono::steady_clock::time_point dequeued, uint64_t arrivedAtDequeue) {
+    // Without a timestamp there is no wait to measure, only the depth is recorded
+    const auto timestamp = messageTimestamp(*inDataPtr);
+    const bool timed = timestamp != std::chrono::steady_clock::time_point();
+    const auto wait = std::chrono::duration_cast<std::chrono::nanoseconds>(dequeued - timestamp);
+    if(timed) _stats->queueWait.record(wait);
+
+    // Whatever arrived and was neither taken by the reader nor discarded on overflow is still queued
+    const uint64_t missingAtReader = _stats->missingAtReader;
+    const uint64_t lostBeforeHost = _stats->lostBeforeHost;
+    const uint64_t overflow = missingAtReader > lostBeforeHost ? missingAtReader - lostBeforeHost : 0;
+    const uint64_t gone = _stats->received + overflow;
+    const uint64_t queued = arrivedAtDequeue > gone ? arrivedAtDequeue - gone : 0;
+    const unsigned depth = static_cast<unsigned>(std::min<uint64_t>(queued, StreamStatsRecord::kQueueDepthBuckets - 1));
+    _stats->queueDepth[depth].fetch_add(1, std::memory_order_relaxed);
+
+    if(timed && _queueTuner && _queueTuner->update(dequeued, wait, depth, overflow, _queueMaxSize, _queueBlocking)) {
+        _daiMessageQueue->setMaxSize(_queueMaxSize);
+        _daiMessageQueue->setBlocking(_queueBlocking);
+#ifdef IS_ROS2
+        RCLCPP_INFO(_node->get_logger(),
+                    "Queue %s resized to %u messages, %s",
+                    _daiMessageQueue->getName().c_str(),
+                    _queueMaxSize,
+                    _queueBlocking ? "blocking" : "non blocking");
+#else
+        ROS_INFO_STREAM_NAMED(LOG_TAG,
+                              "Queue " << _daiMessageQueue->getName() << " resized to " << _queueMaxSize << " messages, "
+                                       << (_queueBlocking ? "blocking" : "non blocking"));
+#endif
+    }
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::publishDiagnostics() {
+    const auto stats = getStats();
+    DiagnosticMsgs::DiagnosticStatus status;
+    status.name = "depthai_bridge: " + _rosTopic;
+    status.hardware_id = _daiMessageQueue->getName();
+
+    const uint64_t lost = stats.lostBeforeHost + stats.queueOverflow;
+    if(lost > _lastReportedLost) {
+        status.level = DiagnosticMsgs::DiagnosticStatus::WARN;
+        status.message = std::to_string(lost - _lastReportedLost) + " frames lost since the last report";
+    } else {
+        status.level = DiagnosticMsgs::DiagnosticStatus::OK;
+        status.message = "OK";
+    }
+    _lastReportedLost = lost;
+
+    auto addValue = [&status](const std::string& key, uint64_t value) {
+        DiagnosticMsgs::KeyValue keyValue;
+        keyValue.key = key;
+        keyValue.value = std::to_string(value);
+        status.values.push_back(keyValue);
+    };
+    addValue("arrived", stats.arrived);
+    addValue("lost before host", stats.lostBeforeHost);
+    addValue("received", stats.received);
+    addValue("queue overflow", stats.queueOverflow);
+    addValue("sequence gaps", stats.sequenceGaps);
+    addValue("filtered", stats.filtered);
+    addValue("no subscriber", stats.noSubscriber);
+    addValue("published", stats.published);
+    if(_arrivalCallbackId >= 0) {
+        const auto queueWait = _stats->queueWait.getCounts();
+        LatencyHistogram::Counts recentQueueWait;
+        for(size_t i = 0; i < recentQueueWait.size(); ++i) recentQueueWait[i] = queueWait[i] - _lastReportedQueueWait[i];
+        _lastReportedQueueWait = queueWait;
+        addValue("queue wait p50 (us)", LatencyHistogram::percentile(recentQueueWait, 0.5).count() / 1000);
+        addValue("queue wait p99 (us)", LatencyHistogram::percentile(recentQueueWait, 0.99).count() / 1000);
+        addValue("queue max size", _daiMessageQueue->getMaxSize());
+    }
+
+    DiagnosticMsgs::DiagnosticArray diagnostics;
+#ifdef IS_ROS2
+    diagnostics.header.stamp = _node->now();
+#else
+    diagnostics.header.stamp = rosOrigin::Time::now();
+#endif
+    diagnostics.status.push_back(status);
+    _diagnosticsPublisher->publish(diagnostics);
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::setReuseMessageBuffers(bool reuse) {
+    _reuseMessageBuffers = reuse;
+}
+
+template <class RosMsg, class SimMsg>
+void BridgePublisher<RosMsg, SimMsg>::publishCameraInfo(const RosMsg& opMsg, const std::string& frameId) {
+    auto localCameraInfo = _camInfoManager->getCameraInfo();
+    detail::matchCameraInfo(opMsg, localCameraInfo);
+#ifndef IS_ROS2
+    localCameraInfo.header.seq = opMsg.header.seq;
+#endif
+    localCameraInfo.header.stamp = opMsg.header.stamp;
+    localCameraInfo.header.frame_id = frameId;
+    _cameraInfoPublisher->publish(localCameraInfo);
+}
+
 template <class RosMsg, class SimMsg>
 void BridgePublisher<RosMsg, SimMsg>::publishHelper(std::shared_ptr<SimMsg> inDataPtr) {
-    RosMsg opMsg;
+    _stats->received++;
+    if(_statsBlock) _stats->cpuTimeNs.store(threadCpuTime().count(), std::memory_order_relaxed);
+    const uint64_t missing = _receivedSequence.update(messageSequenceNum(*inDataPtr));
+    if(missing > 0) {
+        _stats->sequenceGaps++;
+        _stats->missingAtReader += missing;
+    }
+    const auto timestamp = messageTimestamp(*inDataPtr);
+    _hasFrameStamp = timestamp != std::chrono::steady_clock::time_point();
+    if(_hasFrameStamp) _frameStamp = getFrameTime(timestamp);
+
+    // Before the filters, so the budget's windows keep closing while nothing is published
+    if(_latencyBudget) _latencyBudget->update(std::chrono::steady_clock::now());
+
+    for(auto& observer : _frameObservers) {
+        observer(inDataPtr);
+    }
+    for(auto& filter : _publishFilters) {
+        if(!filter(inDataPtr)) {
+            _stats->filtered++;
+            return;
+        }
+    }
+    if(_latencyBudget && _latencyBudget->skipFrame()) {
+        _stats->filtered++;
+        return;
+    }
+
+    RosMsg localMsg;
+    RosMsg& opMsg = _reuseMessageBuffers ? _reusedMsg : localMsg;
     if(_camInfoFrameId.empty()) {
         _converter(inDataPtr, opMsg);
         _camInfoFrameId = opMsg.header.frame_id;
@@ -373,9 +857,42 @@ void BridgePublisher<RosMsg, SimMsg>::publishHelper(std::shared_ptr<SimMsg> inDa
     }
     int numSub = _node->count_subscribers(_rosTopic);
 #endif
-    if(numSub > 0) {
+    // A tier is due once its period has passed since its last frame, and only counts if someone listens
+    _dueTiers.clear();
+    bool tierSubscribed = false;
+    // Messages without a device timestamp are paced by arrival, on the same steady clock
+    const auto frameTime = _hasFrameStamp ? timestamp : std::chrono::steady_clock::now();
+    for(size_t i = 0; i < _rateTiers.size(); ++i) {
+        RateTier& tier = _rateTiers[i];
+#ifndef IS_ROS2
+        const bool subscribed = tier.publisher->getNumSubscribers() > 0;
+#else
+        const bool subscribed = _node->count_subscribers(tier.rosTopic) > 0;
+#endif
+        tierSubscribed = tierSubscribed || subscribed;
+        if(!subscribed || frameTime < tier.nextDue) continue;
+        // Keeps the phase at a steady frame rate, restarts it after a gap instead of catching up
+        tier.nextDue += tier.period;
+        if(tier.nextDue <= frameTime) tier.nextDue = frameTime + tier.period;
+        _dueTiers.push_back(i);
+    }
+
+    bool converted = false;
+    if(numSub > 0 || !_dueTiers.empty()) {
+        const auto conversionStart = std::chrono::steady_clock::now();
         _converter(inDataPtr, opMsg);
-        _rosPublisher->publish(opMsg);
+        if(_hasFrameStamp) opMsg.header.stamp = _frameStamp;
+        converted = true;
+        _stats->conversionTime.record(std::chrono::steady_clock::now() - conversionStart);
+        if(numSub > 0) _rosPublisher->publish(opMsg);
+        for(size_t i : _dueTiers) _rateTiers[i].publisher->publish(opMsg);
+        _stats->published++;
+        if(_hasFrameStamp) {
+            const auto publishedAt = std::chrono::steady_clock::now();
+            const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(publishedAt - timestamp);
+            _stats->latency.record(latency);
+            if(_latencyBudget) _latencyBudget->record(publishedAt, latency);
+        }
 
         if(_isImageMessage) {
 #ifndef IS_ROS2
@@ -384,32 +901,31 @@ void BridgePublisher<RosMsg, SimMsg>::publishHelper(std::shared_ptr<SimMsg> inDa
             infoSubCount = _node->count_subscribers(_cameraName + "/camera_info");
 #endif
 
-            if(infoSubCount > 0) {
-                auto localCameraInfo = _camInfoManager->getCameraInfo();
-#ifndef IS_ROS2
-                localCameraInfo.header.seq = opMsg.header.seq;
-#endif
-                localCameraInfo.header.stamp = opMsg.header.stamp;
-                localCameraInfo.header.frame_id = opMsg.header.frame_id;
-                _cameraInfoPublisher->publish(localCameraInfo);
-            }
+            if(infoSubCount > 0) publishCameraInfo(opMsg, opMsg.header.frame_id);
         }
     }
 
-    if(_isImageMessage && numSub == 0 && infoSubCount > 0) {
+    if(numSub == 0 && infoSubCount == 0 && !tierSubscribed) _stats->noSubscriber++;
+
+    if(_isImageMessage && !converted && infoSubCount > 0) {
         _converter(inDataPtr, opMsg);
-        auto localCameraInfo = _camInfoManager->getCameraInfo();
-#ifndef IS_ROS2
-        localCameraInfo.header.seq = opMsg.header.seq;
-#endif
-        localCameraInfo.header.stamp = opMsg.header.stamp;
-        localCameraInfo.header.frame_id = _camInfoFrameId;
-        _cameraInfoPublisher->publish(localCameraInfo);
+        if(_hasFrameStamp) opMsg.header.stamp = _frameStamp;
+        publishCameraInfo(opMsg, _camInfoFrameId);
+    }
+
+    if(_reuseMessageBuffers) {
+        // Published messages are serialized by now, the buffer is moved to huge page backed memory once it outgrows it
+        auto buffer = messageBuffer(opMsg);
+        if(buffer != nullptr && buffer->size() > _hugePageBytes) {
+            reserveHugePages(*buffer, buffer->size());
+            _hugePageBytes = buffer->capacity();
+        }
     }
 }
 
 template <class RosMsg, class SimMsg>
 BridgePublisher<RosMsg, SimMsg>::~BridgePublisher() {
+    if(_arrivalCallbackId >= 0) _daiMessageQueue->removeCallback(_arrivalCallbackId);
     _readingThread.join();
 }
 
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/msg/auto_focus_ctrl.hpp>
+    #include <depthai_ros_msgs/msg/exposure_ctrl.hpp>
+    #include <depthai_ros_msgs/msg/white_balance_ctrl.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <depthai_ros_msgs/AutoFocusCtrl.h>
+    #include <depthai_ros_msgs/ExposureCtrl.h>
+    #include <depthai_ros_msgs/WhiteBalanceCtrl.h>
+    #include <ros/ros.h>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiMsgs = depthai_ros_msgs::msg;
+#else
+namespace DepthaiMsgs = depthai_ros_msgs;
+#endif
+
+/**
+ * Forwards camera control commands (AutoFocusCtrl, ExposureCtrl, WhiteBalanceCtrl topics and host side callers)
+ * to the device through an XLinkIn CameraControl queue.
+ * Commands arriving within one frame interval are coalesced, the latest value of every setting wins, and sent
+ * as a single dai::CameraControl from a dedicated thread. An isolated command is sent right away.
+ */
+class CameraControlBridge {
+   public:
+    /**
+     * @param controlQueue Input queue of an XLinkIn node linked to the camera's inputControl.
+     * @param topicPrefix Command topics are <topicPrefix>/auto_focus_ctrl, exposure_ctrl and white_balance_ctrl.
+     * @param frameRate Camera frame rate, at most one control message is sent per frame interval.
+     */
+#ifdef IS_ROS2
+    CameraControlBridge(std::shared_ptr<dai::DataInputQueue> controlQueue, std::shared_ptr<rclcpp::Node> node, std::string topicPrefix, float frameRate);
+#else
+    CameraControlBridge(std::shared_ptr<dai::DataInputQueue> controlQueue, ::ros::NodeHandle nh, std::string topicPrefix, float frameRate);
+#endif
+
+    ~CameraControlBridge();
+
+    // Thread safe, host side stages can drive the camera through the same coalescing path as the topics.
+    void setAutoFocus(uint8_t autoFocusMode, bool triggerAutoFocus);
+    void setManualExposure(uint32_t exposureTimeUs, uint32_t sensitivityIso);
+    void setAutoExposure();
+    void setManualWhiteBalance(uint32_t colorTemperature);
+    void setAutoWhiteBalance();
+    void captureStill();
+
+   private:
+    struct PendingControl {
+        bool autoFocusModeSet = false, autoFocusTrigger = false;
+        dai::CameraControl::AutoFocusMode autoFocusMode = dai::CameraControl::AutoFocusMode::AUTO;
+        bool exposureSet = false, autoExposure = false;
+        uint32_t exposureTimeUs = 0, sensitivityIso = 0;
+        bool whiteBalanceSet = false, autoWhiteBalance = false;
+        uint32_t colorTemperature = 0;
+        bool captureStill = false;
+
+        bool empty() const {
+            return !autoFocusModeSet && !autoFocusTrigger && !exposureSet && !whiteBalanceSet && !captureStill;
+        }
+    };
+
+    template <class Setter>
+    void update(Setter setter);
+    void sendingLoop();
+
+    std::shared_ptr<dai::DataInputQueue> _controlQueue;
+    const std::chrono::steady_clock::duration _frameInterval;
+
+#ifdef IS_ROS2
+    std::shared_ptr<rclcpp::Node> _node;
+    rclcpp::Subscription<DepthaiMsgs::AutoFocusCtrl>::SharedPtr _autoFocusSub;
+    rclcpp::Subscription<DepthaiMsgs::ExposureCtrl>::SharedPtr _exposureSub;
+    rclcpp::Subscription<DepthaiMsgs::WhiteBalanceCtrl>::SharedPtr _whiteBalanceSub;
+#else
+    ::ros::NodeHandle _nh;
+    ::ros::Subscriber _autoFocusSub, _exposureSub, _whiteBalanceSub;
+#endif
+
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    PendingControl _pending;
+    std::atomic<bool> _running;
+    std::thread _sendingThread;
+};
+
+template <class Setter>
+void CameraControlBridge::update(Setter setter) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        setter(_pending);
+    }
+    _cv.notify_one();
+}
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/depthaiUtility.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/msg/camera_metadata.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <depthai_ros_msgs/CameraMetadata.h>
+    #include <ros/ros.h>
+
+    #include <boost/make_shared.hpp>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiMsgs = depthai_ros_msgs::msg;
+using CameraMetadataPtr = DepthaiMsgs::CameraMetadata::SharedPtr;
+#else
+namespace DepthaiMsgs = depthai_ros_msgs;
+using CameraMetadataPtr = DepthaiMsgs::CameraMetadata::Ptr;
+#endif
+
+/**
+ * Extracts the capture settings (exposure, ISO, lens position, color temperature) of an ImgFrame.
+ * Only the frame metadata is read, never the pixel data.
+ */
+class CameraMetadataConverter {
+   public:
+    CameraMetadataConverter(const std::string frameName);
+
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::CameraMetadata& outMetadataMsg);
+    CameraMetadataPtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
+
+   private:
+    const std::string _frameName = "";
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/depthaiUtility.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include "rclcpp/rclcpp.hpp"
+    #include "sensor_msgs/image_encodings.hpp"
+    #include "sensor_msgs/msg/image.hpp"
+#else
+    #include <ros/ros.h>
+
+    #include <boost/make_shared.hpp>
+
+    #include "sensor_msgs/Image.h"
+    #include "sensor_msgs/image_encodings.h"
+#endif
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Publishes the StereoDepth confidence map as mono8, paired with the depth frame it belongs to.
+ * Confidence follows the device convention: 0 is the most confident, 255 the least.
+ */
+class ConfidenceMapConverter {
+   public:
+    /**
+     * @param confidenceThreshold Depth pixels whose confidence value is above it are zeroed by the paired toRosMsg(),
+     *                            255 disables the masking.
+     */
+    ConfidenceMapConverter(const std::string frameName, uint8_t confidenceThreshold = 255);
+
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::Image& outImageMsg);
+    ImagePtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
+
+    /**
+     * Converts a depth frame and its confidence map with one shared header, masking the depth while it is copied.
+     * Both frames must come from the same StereoDepth output (same sequence number and size), throws otherwise, or if
+     * the depth is not RAW16, the confidence map not RAW8/GRAY8, or either buffer is shorter than its size needs.
+     */
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> depthData,
+                  std::shared_ptr<dai::ImgFrame> confidenceData,
+                  ImageMsgs::Image& outDepthMsg,
+                  ImageMsgs::Image& outConfidenceMsg);
+
+    /**
+     * Zeros the RAW16 depth pixels whose confidence value is above the threshold, in place in the depthai buffer,
+     * so the frame can be handed to any other converter afterwards. Throws for the same pairs as toRosMsg().
+     */
+    static void maskDepth(dai::ImgFrame& depthData, dai::ImgFrame& confidenceData, uint8_t confidenceThreshold);
+
+   private:
+    static void checkPair(dai::ImgFrame& depthData, dai::ImgFrame& confidenceData);
+
+    const std::string _frameName = "";
+    const uint8_t _confidenceThreshold;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
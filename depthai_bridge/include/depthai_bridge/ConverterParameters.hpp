@@ -0,0 +1,109 @@
+#pragma once
+
+#include <chrono>
+#include <depthai_bridge/DisparityConverter.hpp>
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/ImgDetectionConverter.hpp>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#ifdef IS_ROS2
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <ros/ros.h>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Exposes converter configs as ROS parameters, so a running bridge can be retuned without recreating its publishers.
+ * Each bind() declares the converter's parameters under a prefix, initialized from its current config, or applies
+ * values already set for them e.g. from a launch file. Later changes are validated and swapped into the converter from
+ * its next frame on:
+ *  - ROS2 through a set parameters callback, a set with any invalid value is rejected as a whole
+ *  - ROS1 by polling the cached parameters, the changes of a converter with any invalid value are logged and ignored
+ * The changes of a converter are applied to a copy of its config, which replaces the old one in a single swap once all
+ * of them are valid, so no frame is converted with only part of them. Bind before spinning; the bound converters have
+ * to outlive this object.
+ *
+ * ImageConverter     <prefix>.frame_id, mono_output, downscale, enhancement (none, equalize, clahe), clahe_clip_limit,
+ *                    clahe_tiles
+ * DisparityConverter <prefix>.frame_id, focal_length, baseline, min_depth, max_depth (centimeters)
+ * ImgDetectionConverter <prefix>.frame_id, width, height, normalized
+ * ROS1 separates the prefix with '/' instead of '.'.
+ */
+class ConverterParameters {
+   public:
+#ifdef IS_ROS2
+    explicit ConverterParameters(std::shared_ptr<rclcpp::Node> node);
+#else
+    explicit ConverterParameters(::ros::NodeHandle nh, std::chrono::milliseconds pollPeriod = std::chrono::milliseconds(1000));
+#endif
+
+    void bind(const std::string& prefix, ImageConverter& converter);
+    void bind(const std::string& prefix, DisparityConverter& converter);
+    void bind(const std::string& prefix, ImgDetectionConverter& converter);
+
+   private:
+    // A bound converter and the copy of its config that parameter changes are staged into
+    struct Binding {
+        std::string prefix;
+        // Restarts the staged config from the converter's current one
+        std::function<void()> stage;
+        // Throws for a staged config the converter does not accept
+        std::function<void()> validate;
+        // Swaps the staged config into the converter
+        std::function<void()> commit;
+    };
+
+    // Adds a binding for the converter and returns its staged config
+    template <class Converter>
+    std::shared_ptr<typename Converter::Config> addBinding(const std::string& prefix, Converter& converter);
+
+    // Declares a parameter of the last added binding. stage writes a value into the staged config, overrides of the
+    // initial value are committed together once the binding's parameters are all declared, see commitOverrides().
+    template <class T>
+    void declare(const std::string& name, const T& initial, std::function<void(const T&)> stage);
+
+    void commitOverrides();
+
+    std::string parameterName(const std::string& prefix, const std::string& name) const;
+
+    std::vector<Binding> _bindings;
+
+#ifdef IS_ROS2
+    rcl_interfaces::msg::SetParametersResult onSetParameters(const std::vector<rclcpp::Parameter>& parameters);
+
+    std::shared_ptr<rclcpp::Node> _node;
+    rclcpp::node_interfaces::OnSetParametersCallbackHandle::SharedPtr _callbackHandle;
+    struct Handler {
+        size_t binding;
+        // Throws rclcpp::ParameterTypeException for a value of the wrong type
+        std::function<void(const rclcpp::Parameter&)> stage;
+    };
+    std::map<std::string, Handler> _handlers;
+#else
+    void poll();
+
+    struct Poller {
+        size_t binding;
+        // Stages the parameter if it changed since it was last seen, returns whether it did
+        std::function<bool()> stageChanged;
+    };
+
+    ::ros::NodeHandle _nh;
+    ::ros::WallTimer _pollTimer;
+    std::vector<Poller> _pollers;
+#endif
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
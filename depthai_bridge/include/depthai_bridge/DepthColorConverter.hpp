@@ -0,0 +1,54 @@
+#pragma once
+
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/depthaiUtility.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include "rclcpp/rclcpp.hpp"
+    #include "sensor_msgs/image_encodings.hpp"
+    #include "sensor_msgs/msg/image.hpp"
+#else
+    #include <ros/ros.h>
+
+    #include <boost/make_shared.hpp>
+
+    #include "sensor_msgs/Image.h"
+    #include "sensor_msgs/image_encodings.h"
+#endif
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Colorizes disparity or depth frames into a bgr8 image for visualization.
+ * Every possible input value is mapped through a lookup table computed once, so a frame costs one table read per pixel.
+ * Used with a BridgePublisher the conversion only runs while the topic has subscribers.
+ */
+class DepthColorConverter {
+   public:
+    enum class Source { DISPARITY, DEPTH };
+    enum class ColorMap { JET, TURBO };
+
+    /**
+     * @param minValue, maxValue Input range spread over the color map: raw disparity units (x8 or x32 for subpixel)
+     *                           for DISPARITY, millimeters for DEPTH. Near is red for both sources, invalid (0) pixels are black.
+     */
+    DepthColorConverter(const std::string frameName, Source source, float minValue, float maxValue, ColorMap colorMap = ColorMap::TURBO);
+
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::Image& outImageMsg);
+    ImagePtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
+
+   private:
+    const std::string _frameName = "";
+    // BGR triplet for every 16 bit input value, RAW8 disparity only touches the first 256 entries.
+    std::vector<uint8_t> _lut;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
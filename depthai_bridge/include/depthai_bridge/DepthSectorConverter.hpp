@@ -0,0 +1,75 @@
+#pragma once
+
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/depthaiUtility.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/msg/depth_sectors.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <depthai_ros_msgs/DepthSectors.h>
+    #include <ros/ros.h>
+
+    #include <boost/make_shared.hpp>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiMsgs = depthai_ros_msgs::msg;
+using DepthSectorsPtr = DepthaiMsgs::DepthSectors::SharedPtr;
+#else
+namespace DepthaiMsgs = depthai_ros_msgs;
+using DepthSectorsPtr = DepthaiMsgs::DepthSectors::Ptr;
+#endif
+
+/**
+ * Reduces a RAW16 depth frame (millimeters) to the nearest obstacle distance in N horizontal angular sectors.
+ */
+class DepthSectorConverter {
+   public:
+    /**
+     * @param cameraInfo Intrinsics of the depth frame, e.g. from ImageConverter::calibrationToCameraInfo(). Throws for a
+     * focal length that is not positive.
+     * @param minDepth, maxDepth Valid depth range in meters, depth outside of it is ignored. Throws unless minDepth < maxDepth
+     * at millimeter resolution.
+     * @param percentile Percentile (0..1) of the per column nearest depths reported in percentile_ranges, throws outside of it.
+     * @param rowBegin, rowEnd Band of image rows taken into account, rowEnd = -1 means up to the last row.
+     */
+    DepthSectorConverter(const std::string frameName,
+                         const ImageMsgs::CameraInfo& cameraInfo,
+                         int numSectors,
+                         float minDepth = 0.2,
+                         float maxDepth = 10.0,
+                         float percentile = 0.1,
+                         int rowBegin = 0,
+                         int rowEnd = -1);
+
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::DepthSectors& outSectorsMsg);
+    DepthSectorsPtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
+
+   private:
+    const std::string _frameName = "";
+    const int _width, _numSectors;
+    const float _minDepth, _maxDepth, _percentile;
+    const int _rowBegin, _rowEnd;
+    float _angleMin, _angleIncrement;
+    uint16_t _minDepthMm, _depthRangeMm;
+
+    // Sector index of every image column, computed once from the intrinsics.
+    std::vector<uint16_t> _columnSector;
+    // Per frame scratch buffers, kept to avoid allocations.
+    std::vector<uint16_t> _columnMin;
+    std::vector<std::vector<uint16_t>> _sectorColumns;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
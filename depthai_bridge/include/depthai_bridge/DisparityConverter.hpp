@@ -1,5 +1,6 @@
 #pragma once
 
+#include <depthai_bridge/SwappableConfig.hpp>
 #include <iostream>
 #include <opencv2/opencv.hpp>
 #include <sstream>
@@ -37,16 +38,33 @@ using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono
 
 class DisparityConverter {
    public:
+    struct Config {
+        std::string frameName;
+        float focalLength = 882.2;
+        // In centimeters
+        float baseline = 7.5, minDepth = 80, maxDepth = 1100;
+    };
+
     DisparityConverter(const std::string frameName, float focalLength, float baseline = 7.5, float minDepth = 80, float maxDepth = 1100);
 
     void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DisparityMsgs::DisparityImage& outImageMsg);
     DisparityImagePtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
 
+    Config getConfig() const;
+
+    /**
+     * Replaces the configuration from the next frame on, safe to call while another thread converts.
+     * Throws unless the focal length and baseline are positive and 0 < minDepth < maxDepth.
+     */
+    void setConfig(Config config);
+
+    // Throws for a config setConfig() would reject
+    static void validate(const Config& config);
+
     // void toDaiMsg(const DisparityMsgs::DisparityImage& inMsg, dai::ImgFrame& outData);
 
    private:
-    const std::string _frameName = "";
-    const float _focalLength = 882.2, _baseline = 7.5, _minDepth = 80, _maxDepth;
+    SwappableConfig<Config> _config;
 };
 
 }  // namespace ros
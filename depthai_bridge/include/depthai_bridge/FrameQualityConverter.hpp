@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <depthai_bridge/depthaiUtility.hpp>
+#include <opencv2/opencv.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/msg/frame_quality.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <depthai_ros_msgs/FrameQuality.h>
+    #include <ros/ros.h>
+
+    #include <boost/make_shared.hpp>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiMsgs = depthai_ros_msgs::msg;
+using FrameQualityPtr = DepthaiMsgs::FrameQuality::SharedPtr;
+#else
+namespace DepthaiMsgs = depthai_ros_msgs;
+using FrameQualityPtr = DepthaiMsgs::FrameQuality::Ptr;
+#endif
+
+/**
+ * Scores the sharpness (Laplacian variance) and exposure (mean, clipped fractions) of an ImgFrame on its luma plane,
+ * area downsampled by a factor first so a 1080p frame costs well under a millisecond. Meant for
+ * BridgePublisher::addSidePublisher(), which only runs it while the quality topic has subscribers.
+ * Luma is the Y plane of NV12/YUV420p, the image of GRAY8/RAW8, the gray conversion of interleaved RGB/BGR and the
+ * green plane of planar RGB/BGR. Other types get a message with zero scores.
+ */
+class FrameQualityConverter {
+   public:
+    FrameQualityConverter(const std::string frameName, int downsample = 4, uint8_t darkThreshold = 5, uint8_t brightThreshold = 250);
+
+    void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::FrameQuality& outQualityMsg);
+    FrameQualityPtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
+
+   private:
+    // Downsampled luma of the frame into _luma, false for types without one
+    bool downsampleLuma(std::shared_ptr<dai::ImgFrame> inData);
+
+    const std::string _frameName;
+    const int _downsample;
+    const uint8_t _darkThreshold, _brightThreshold;
+    // Reused between frames
+    cv::Mat _luma, _color, _laplacian;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/srv/trigger_named.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+    #include "sensor_msgs/msg/image.hpp"
+#else
+    #include <depthai_ros_msgs/TriggerNamed.h>
+    #include <ros/ros.h>
+
+    #include "sensor_msgs/Image.h"
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace ImageMsgs = sensor_msgs::msg;
+namespace DepthaiSrvs = depthai_ros_msgs::srv;
+#else
+namespace ImageMsgs = sensor_msgs;
+namespace DepthaiSrvs = depthai_ros_msgs;
+#endif
+
+/**
+ * Keeps the last few seconds of raw device frames (NV12, RAW16, ...) without converting them.
+ * Calling the TriggerNamed service converts the buffered frames and publishes them as a burst, oldest first,
+ * so incident capture does not need continuous full rate recording. One burst is published at a time, triggers that
+ * come in meanwhile are rejected.
+ */
+class FrameRingBuffer {
+   public:
+    // Runs on the buffer's publishing thread, concurrently with the live publisher. ImageConverter can be shared with
+    // it, converters that keep per-frame state must not be.
+    using ConvertFunc = std::function<void(std::shared_ptr<dai::ImgFrame>, ImageMsgs::Image&)>;
+
+    /**
+     * @param history Frames older than this, relative to the newest frame, are released.
+     * @param maxBytes Upper bound of the buffered pixel data, the oldest frames are released first. Frames of the burst
+     * being published count against it until they are published, so the buffer holds fewer new frames meanwhile.
+     */
+#ifdef IS_ROS2
+    FrameRingBuffer(std::shared_ptr<rclcpp::Node> node,
+                    std::string serviceName,
+                    std::string burstTopic,
+                    ConvertFunc converter,
+                    std::chrono::milliseconds history,
+                    size_t maxBytes);
+#else
+    FrameRingBuffer(::ros::NodeHandle nh, std::string serviceName, std::string burstTopic, ConvertFunc converter, std::chrono::milliseconds history, size_t maxBytes);
+#endif
+
+    ~FrameRingBuffer();
+
+    /**
+     * Stores the frame, only its shared pointer is kept so the device buffer is reused instead of copied.
+     * Meant to be registered as a BridgePublisher frame observer.
+     */
+    void addFrame(std::shared_ptr<dai::ImgFrame> inData);
+
+    /**
+     * Hands the currently buffered frames to the publishing thread, returns the number of frames in the burst.
+     * Throws if the previous burst is still being published.
+     * The name passed to the service only labels the service response, the burst itself carries no name.
+     */
+    size_t trigger();
+
+   private:
+#ifdef IS_ROS2
+    void triggerCallback(const std::shared_ptr<DepthaiSrvs::TriggerNamed::Request> request, std::shared_ptr<DepthaiSrvs::TriggerNamed::Response> response);
+#else
+    bool triggerCallback(DepthaiSrvs::TriggerNamed::Request& request, DepthaiSrvs::TriggerNamed::Response& response);
+#endif
+    void publishingLoop();
+
+    ConvertFunc _converter;
+    const std::chrono::milliseconds _history;
+    const size_t _maxBytes;
+
+#ifdef IS_ROS2
+    std::shared_ptr<rclcpp::Node> _node;
+    rclcpp::Publisher<ImageMsgs::Image>::SharedPtr _burstPublisher;
+    rclcpp::Service<DepthaiSrvs::TriggerNamed>::SharedPtr _triggerService;
+#else
+    ::ros::NodeHandle _nh;
+    ::ros::Publisher _burstPublisher;
+    ::ros::ServiceServer _triggerService;
+#endif
+
+    // Guards the buffered frames and the burst, which share the byte budget
+    std::mutex _framesMutex;
+    std::deque<std::shared_ptr<dai::ImgFrame>> _frames;
+    // Frames ever added, so _frames.front() is frame number _addedFrames - _frames.size()
+    uint64_t _addedFrames = 0;
+    // Bytes held by _frames, and by frames of the burst that _frames released already
+    size_t _bufferedBytes = 0, _burstOnlyBytes = 0;
+
+    std::condition_variable _burstCv;
+    // Frames of the burst not published yet, the first one being frame number _burstFirst
+    std::deque<std::shared_ptr<dai::ImgFrame>> _burst;
+    uint64_t _burstFirst = 0;
+    std::atomic<bool> _running;
+    std::thread _publishingThread;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Replaces buffer with an empty one of at least size bytes capacity whose pages are advised for transparent huge pages
+ * (madvise MADV_HUGEPAGE), so filling a multi megabyte frame faults in 2 MB pages instead of thousands of 4 KB ones.
+ * The previous content is discarded. Without THP support this is a plain reserve.
+ */
+void reserveHugePages(std::vector<uint8_t>& buffer, size_t size);
+
+namespace detail {
+
+template <class Msg>
+auto messageBuffer(Msg& msg, int) -> decltype(static_cast<std::vector<uint8_t>*>(&msg.data)) {
+    return &msg.data;
+}
+
+template <class Msg>
+auto messageBuffer(Msg& msg, long) -> decltype(static_cast<std::vector<uint8_t>*>(&msg.image.data)) {
+    return &msg.image.data;
+}
+
+template <class Msg>
+std::vector<uint8_t>* messageBuffer(Msg&, ...) {
+    return nullptr;
+}
+
+}  // namespace detail
+
+/**
+ * Pixel or point buffer of a message: data for Image and PointCloud2, image.data for DisparityImage, nullptr otherwise.
+ */
+template <class Msg>
+std::vector<uint8_t>* messageBuffer(Msg& msg) {
+    return detail::messageBuffer(msg, 0);
+}
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <depthai_bridge/LatencyHistogram.hpp>
+#include <depthai_bridge/SwappableConfig.hpp>
 #include <iostream>
 #include <opencv2/opencv.hpp>
 #include <sstream>
@@ -41,13 +43,65 @@ using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono
 
 class ImageConverter {
    public:
+    enum class Enhancement { NONE, EQUALIZE, CLAHE };
+
+    struct Config {
+        std::string frameName;
+        // See setMonoOutput(), setDownscale() and setEnhancement()
+        bool monoOutput = false;
+        unsigned downscale = 1;
+        Enhancement enhancement = Enhancement::NONE;
+        double claheClipLimit = 2.0;
+        int claheTiles = 8;
+    };
+
     // ImageConverter() = default;
     ImageConverter(const std::string frameName, bool interleaved);
     ImageConverter(bool interleaved);
 
+    // Reentrant, one converter can convert on several threads at once, e.g. for a BridgePublisher and a FrameRingBuffer
     void toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::Image& outImageMsg);
     ImagePtr toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData);
 
+    Config getConfig() const;
+
+    /**
+     * Replaces the whole configuration from the next frame on, safe to call while another thread converts.
+     * Throws for a downscale of 0, a CLAHE clip limit that is not positive or less than one CLAHE tile.
+     */
+    void setConfig(Config config);
+
+    // Throws for a config setConfig() would reject
+    static void validate(const Config& config);
+
+    void setFrameName(std::string frameName);
+
+    /**
+     * Publishes NV12 and YUV420p frames as mono8 from their luma plane, skipping the color conversion.
+     * Other types are not affected.
+     */
+    void setMonoOutput(bool mono);
+
+    /**
+     * Publishes at 1/factor of the width and height. NV12 and YUV420p are shrunk before the color conversion, so
+     * converting costs less as well, GRAY8, RAW8 and RAW16 are resized into the message. Other types, and YUV frames
+     * whose size is not a multiple of 2 * factor, are published at full resolution. BridgePublisher scales the camera
+     * info it publishes alongside to the size of the image. Throws for a factor of 0.
+     */
+    void setDownscale(unsigned factor);
+
+    /**
+     * Contrast enhancement of mono8 output (GRAY8, RAW8, and NV12/YUV420p with setMonoOutput()), written straight into
+     * the message buffer: EQUALIZE is a global histogram equalization applied through a lookup table, CLAHE is
+     * cv::CLAHE over claheTiles x claheTiles tiles, both parallelized by OpenCV. Applied after downscaling.
+     */
+    void setEnhancement(Enhancement enhancement, double claheClipLimit = 2.0, int claheTiles = 8);
+
+    /**
+     * Time spent in the enhancement per frame, can be read while converting. Copies of the converter share it.
+     */
+    const LatencyHistogram& getEnhancementTime() const;
+
     void toDaiMsg(const ImageMsgs::Image& inMsg, dai::ImgFrame& outData);
 
     /** TODO(sachin): Add support for ros msg to cv mat since we have some
@@ -69,7 +123,11 @@ class ImageConverter {
     // dai::RawImgFrame::Type _srcType;
     bool _daiInterleaved;
     // bool c
-    const std::string _frameName = "";
+    SwappableConfig<Config> _config;
+    std::shared_ptr<LatencyHistogram> _enhancementTime = std::make_shared<LatencyHistogram>();
+    void reducedYuvToRosMsg(std::shared_ptr<dai::ImgFrame> inData, const Config& config, unsigned scale, ImageMsgs::Image& outImageMsg);
+    // Enhances input into output as configured, returns false without touching output if the enhancement is off
+    bool enhanceMono(const Config& config, const cv::Mat& input, cv::Mat& output);
     void planarToInterleaved(const std::vector<uint8_t>& srcData, std::vector<uint8_t>& destData, int w, int h, int numPlanes, int bpp);
     void interleavedToPlanar(const std::vector<uint8_t>& srcData, std::vector<uint8_t>& destData, int w, int h, int numPlanes, int bpp);
 };
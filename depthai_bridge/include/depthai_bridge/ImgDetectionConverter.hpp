@@ -29,6 +29,13 @@ using Detection2DArrayPtr = VisionMsgs::Detection2DArray::Ptr;
 #endif
 class ImgDetectionConverter {
    public:
+    struct Config {
+        std::string frameName;
+        // Size of the image the detections are scaled to, unless they are published normalized
+        int width = 0, height = 0;
+        bool normalized = false;
+    };
+
     // DetectionConverter() = default;
     ImgDetectionConverter(std::string frameName, int width, int height, bool normalized = false);
 
@@ -38,11 +45,23 @@ class ImgDetectionConverter {
 
     Detection2DArrayPtr toRosMsgPtr(std::shared_ptr<dai::ImgDetections> inNetData);
 
+    Config getConfig() const;
+
+    /**
+     * Replaces the configuration from the next message on, safe to call while another thread converts.
+     * Throws for a non positive width or height, unless publishing normalized detections.
+     */
+    void setConfig(Config config);
+
+    // Throws for a config setConfig() would reject
+    static void validate(const Config& config);
+
    private:
+    // Frame id and detections of the message from one config snapshot
+    void detectionsToRosMsg(std::shared_ptr<dai::ImgDetections> inNetData, const Config& config, VisionMsgs::Detection2DArray& opDetectionMsg);
+
     uint32_t _sequenceNum;
-    int _width, _height;
-    const std::string _frameName;
-    bool _normalized;
+    SwappableConfig<Config> _config;
 };
 
 /** TODO(sachin): Do we need to have ros msg -> dai bounding box ?
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+
+#include "depthai/depthai.hpp"
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Time indexed history of IMU samples for host stages that need IMU values at arbitrary timestamps
+ * (motion blur gating, preintegration, rolling shutter correction).
+ * Accelerometer, gyroscope and rotation vector reports are kept in separate rings, since they may run at different
+ * rates, each stored as a structure of arrays indexed by the report timestamps (the device clock as synced to the
+ * host steady clock by depthai, the same clock as ImgFrame::getTimestamp()).
+ * One thread writes (addImuData, e.g. from the IMU BridgePublisher), any number of threads query concurrently
+ * without locks; a query that races with the writer overwriting the samples it read is retried.
+ */
+class ImuSampleStore {
+   public:
+    using TimePoint = std::chrono::steady_clock::time_point;
+
+    struct Vector3 {
+        float x, y, z;
+    };
+
+    struct Quaternion {
+        float x, y, z, w;
+    };
+
+    /**
+     * @param capacity Samples kept per sensor, rounded up to a power of two.
+     */
+    explicit ImuSampleStore(size_t capacity = 4096);
+
+    // Single writer. Reports not newer than the last stored one of the same sensor are skipped.
+    void addImuData(std::shared_ptr<dai::IMUData> inData);
+
+    // Linearly interpolated values at t. Return false if t is outside of the stored history.
+    bool getAcceleration(TimePoint t, Vector3& acceleration) const;
+    bool getAngularVelocity(TimePoint t, Vector3& angularVelocity) const;
+    // Normalized linear interpolation between the closest rotation vector reports
+    bool getOrientation(TimePoint t, Quaternion& orientation) const;
+
+    // Trapezoidal integrals over [begin, end]. Return false if the range is not fully covered by the stored history.
+    bool integrateAngularVelocity(TimePoint begin, TimePoint end, Vector3& rotation) const;
+    bool integrateAngularSpeed(TimePoint begin, TimePoint end, float& angle) const;
+    bool integrateAcceleration(TimePoint begin, TimePoint end, Vector3& velocityChange) const;
+
+   private:
+    template <size_t Channels>
+    class Ring {
+       public:
+        using Sample = std::array<float, Channels>;
+
+        explicit Ring(size_t capacity);
+
+        void push(int64_t timestamp, const Sample& sample);
+
+        // Samples surrounding t and the interpolation weight of the later one
+        bool lookup(int64_t t, Sample& before, Sample& after, float& weight) const;
+
+        template <size_t K, class Integrand>
+        bool integrate(int64_t begin, int64_t end, Integrand integrand, std::array<float, K>& integral) const;
+
+       private:
+        // First index in [lo, hi) with a timestamp >= t
+        uint64_t lowerBound(uint64_t lo, uint64_t hi, int64_t t) const;
+        Sample load(uint64_t index) const;
+        // True if samples from index lo on were not overwritten since the reader loaded head
+        bool stillValid(uint64_t lo) const;
+
+        const uint64_t _capacity, _mask;
+        std::unique_ptr<std::atomic<int64_t>[]> _timestamps;
+        std::array<std::unique_ptr<std::atomic<float>[]>, Channels> _channels;
+        std::atomic<uint64_t> _head;
+        int64_t _lastTimestamp;
+    };
+
+    Ring<3> _accelerometer, _gyroscope;
+    Ring<4> _rotationVector;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Device timestamp to publish latency budget of one stream, degrading its output step by step while the budget is
+ * missed so that a loaded host drops quality instead of building up a backlog:
+ *  SKIP_FRAMES  every other frame is dropped before conversion, done by BridgePublisher itself
+ *  MONO         and color is dropped, e.g. ImageConverter::setMonoOutput()
+ *  DOWNSCALE    and the resolution is reduced, e.g. ImageConverter::setDownscale()
+ * MONO and DOWNSCALE are up to the level callback, which runs on the publishing thread between two conversions, so it
+ * can reconfigure the stream's converter directly.
+ *
+ * Once per window the level goes up when more than 10 % of the frames missed the budget, and back down after three
+ * windows in a row with every frame within 70 % of it. Windows are closed on every received frame, so one without any
+ * published frame, e.g. while nobody subscribes or a publish filter drops everything, counts as within budget and the
+ * level keeps recovering.
+ */
+class LatencyBudget {
+   public:
+    enum class Level { FULL, SKIP_FRAMES, MONO, DOWNSCALE };
+    using LevelCallback = std::function<void(Level)>;
+
+    explicit LatencyBudget(std::chrono::milliseconds budget, std::chrono::milliseconds window = std::chrono::milliseconds(1000));
+
+    void setLevelCallback(LevelCallback callback);
+
+    /**
+     * Closes the current window once it has passed, to be called for every received frame whether it gets published or
+     * not. May change the level and call the level callback.
+     */
+    void update(std::chrono::steady_clock::time_point now);
+
+    /**
+     * Accounts the latency of a published frame, then calls update().
+     */
+    void record(std::chrono::steady_clock::time_point now, std::chrono::nanoseconds latency);
+
+    /**
+     * Whether the next frame is to be dropped, true for every other frame from SKIP_FRAMES on.
+     */
+    bool skipFrame();
+
+    Level getLevel() const;
+
+   private:
+    void setLevel(Level level);
+
+    const std::chrono::nanoseconds _budget;
+    const std::chrono::milliseconds _window;
+    LevelCallback _levelCallback;
+    std::atomic<Level> _level;
+
+    bool _started = false;
+    std::chrono::steady_clock::time_point _windowStart;
+    uint64_t _samples = 0, _overBudget = 0;
+    std::chrono::nanoseconds _maxLatency{0};
+    int _calmWindows = 0;
+    bool _skipped = false;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
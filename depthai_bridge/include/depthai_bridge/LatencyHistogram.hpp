@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Fixed size, log scaled histogram of durations, four buckets per power of two from 1 us up to about an hour.
+ * Recording is a single relaxed atomic increment, so it can live in shared memory and be read by another process
+ * while it is written. Percentiles are resolved to the upper bound of a bucket, i.e. within 25 %.
+ */
+class LatencyHistogram {
+   public:
+    static constexpr size_t kBuckets = 128;
+    using Counts = std::array<uint64_t, kBuckets>;
+
+    LatencyHistogram();
+
+    void record(std::chrono::nanoseconds value);
+
+    Counts getCounts() const;
+
+    /**
+     * Upper bound of the bucket holding the given fraction (0..1) of the counts, zero for an empty histogram.
+     * Works on the difference of two getCounts() snapshots as well, for percentiles over a time window.
+     */
+    static std::chrono::nanoseconds percentile(const Counts& counts, double fraction);
+
+    static size_t bucketIndex(uint64_t nanoseconds);
+    static uint64_t bucketUpperBound(size_t index);
+
+   private:
+    std::array<std::atomic<uint64_t>, kBuckets> _counts;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <depthai_bridge/ImuSampleStore.hpp>
+
+#include "depthai/depthai.hpp"
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Drops (or just measures) image frames captured during fast rotation, before they are converted.
+ * The angular speed is integrated over every frame's exposure window, taken as [timestamp - exposure time, timestamp],
+ * from the gyroscope history of an ImuSampleStore fed by the IMU queue:
+ *   imuPublisher.addFrameObserver([store](std::shared_ptr<dai::IMUData> imu) { store->addImuData(imu); });
+ *   imagePublisher.addPublishFilter([gate](std::shared_ptr<dai::ImgFrame> frame) { return gate->isSharp(frame); });
+ */
+class MotionBlurGate {
+   public:
+    /**
+     * @param maxRotation Rotation, in radians, accumulated during the exposure above which a frame counts as blurred.
+     */
+    MotionBlurGate(std::shared_ptr<ImuSampleStore> imuStore, float maxRotation);
+
+    /**
+     * Rotation accumulated during the frame's exposure, in radians. Returns false if the stored gyroscope samples
+     * do not cover the exposure window yet, e.g. when the IMU queue lags behind the image queue.
+     */
+    bool estimateRotation(std::shared_ptr<dai::ImgFrame> inData, float& rotation) const;
+
+    /**
+     * False for frames whose exposure rotation exceeds maxRotation. Frames that can not be judged are let through.
+     */
+    bool isSharp(std::shared_ptr<dai::ImgFrame> inData) const;
+
+   private:
+    std::shared_ptr<ImuSampleStore> _imuStore;
+    const float _maxRotation;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
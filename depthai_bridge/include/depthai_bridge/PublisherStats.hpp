@@ -0,0 +1,98 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Message counts of one BridgePublisher, attributing lost frames to the stage that lost them.
+ */
+struct PublisherStats {
+    // Messages that reached the host side DataOutputQueue, and those missing from its sequence numbers,
+    // i.e. lost on the device or on the link
+    uint64_t arrived = 0;
+    uint64_t lostBeforeHost = 0;
+    // Messages taken from the queue by the bridge, and those the queue discarded on overflow in between
+    uint64_t received = 0;
+    uint64_t queueOverflow = 0;
+    // Gaps in the sequence numbers of the received messages, whatever stage caused them
+    uint64_t sequenceGaps = 0;
+    // Received messages rejected by a publish filter, not converted for lack of subscribers, and published
+    uint64_t filtered = 0;
+    uint64_t noSubscriber = 0;
+    uint64_t published = 0;
+};
+
+namespace detail {
+
+template <class Msg>
+auto sequenceNum(Msg& msg, int) -> decltype(static_cast<int64_t>(msg.getSequenceNum())) {
+    return msg.getSequenceNum();
+}
+
+template <class Msg>
+int64_t sequenceNum(Msg&, ...) {
+    return -1;
+}
+
+template <class Msg>
+auto timestamp(Msg& msg, int) -> decltype(std::chrono::steady_clock::time_point(msg.getTimestamp())) {
+    return msg.getTimestamp();
+}
+
+template <class Msg>
+std::chrono::steady_clock::time_point timestamp(Msg&, ...) {
+    return {};
+}
+
+}  // namespace detail
+
+/**
+ * Sequence number of a depthai message, -1 for types without one at the message level (IMUData in older depthai-core).
+ */
+template <class Msg>
+int64_t messageSequenceNum(Msg& msg) {
+    return detail::sequenceNum(msg, 0);
+}
+
+/**
+ * Host synced device timestamp of a depthai message, a default constructed time point for types without one at the
+ * message level.
+ */
+template <class Msg>
+std::chrono::steady_clock::time_point messageTimestamp(Msg& msg) {
+    return detail::timestamp(msg, 0);
+}
+
+/**
+ * Finds the messages missing from a stream of sequence numbers.
+ */
+class SequenceTracker {
+   public:
+    // Number of messages missing between the previous sequence number and this one
+    uint64_t update(int64_t sequenceNum) {
+        // Messages without a sequence number are not tracked
+        if(sequenceNum < 0) return 0;
+        uint64_t missing = 0;
+        // A sequence number going backwards means the device restarted the stream, start over
+        if(_hasLast && sequenceNum > _last + 1) {
+            missing = static_cast<uint64_t>(sequenceNum - _last - 1);
+        }
+        _last = sequenceNum;
+        _hasLast = true;
+        return missing;
+    }
+
+   private:
+    int64_t _last = 0;
+    bool _hasLast = false;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Adjusts the size and blocking mode of a host side DataOutputQueue so that messages wait in it no longer than a target.
+ * Fed with every message taken from the queue, it decides once per interval:
+ *  - more than 5 % of the waits over the target while messages were queued up behind each other: the queue is the
+ *    cause, halve its size and make it non blocking so the oldest messages are discarded instead of read late
+ *  - no wait over the target but messages discarded by the queue: grow it by one, up to the size it started with
+ * Waits over the target with an empty queue come from the device or the link and leave the queue alone.
+ */
+class QueueTuner {
+   public:
+    QueueTuner(std::chrono::nanoseconds targetWait, unsigned maxSizeLimit, std::chrono::milliseconds interval = std::chrono::milliseconds(2000));
+
+    /**
+     * Accounts one dequeued message. depth is the number of messages left in the queue behind it, overflowTotal the
+     * number of messages the queue discarded so far. Returns true when maxSize or blocking were changed, to be
+     * applied to the queue by the caller.
+     */
+    bool update(std::chrono::steady_clock::time_point now,
+                std::chrono::nanoseconds wait,
+                unsigned depth,
+                uint64_t overflowTotal,
+                unsigned& maxSize,
+                bool& blocking);
+
+   private:
+    const std::chrono::nanoseconds _targetWait;
+    const unsigned _maxSizeLimit;
+    const std::chrono::milliseconds _interval;
+
+    bool _started = false;
+    std::chrono::steady_clock::time_point _windowStart;
+    uint64_t _windowOverflowStart = 0;
+    uint64_t _samples = 0, _overTarget = 0, _queuedUp = 0;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
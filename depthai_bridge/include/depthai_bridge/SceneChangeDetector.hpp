@@ -0,0 +1,56 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Static scene suppression for fixed cameras. Compares a coarse grid of block averages, sampled from the raw device
+ * buffer before any conversion, against the last frame that was let through. Frames of an unchanged scene are dropped,
+ * except for one every keepAlive interval so subscribers still see the stream is alive.
+ * Meant to be registered as a BridgePublisher publish filter:
+ *   publisher.addPublishFilter([detector](std::shared_ptr<dai::ImgFrame> frame) { return detector->hasChanged(frame); });
+ */
+class SceneChangeDetector {
+   public:
+    /**
+     * @param threshold Mean absolute difference of the grid, in 8 bit levels, above which the scene counts as changed.
+     * @param keepAlive A frame of a static scene is still let through at least this often.
+     * @param gridWidth, gridHeight Number of 4x4 blocks sampled across the first plane of the frame.
+     */
+    SceneChangeDetector(float threshold = 2.0f,
+                        std::chrono::milliseconds keepAlive = std::chrono::milliseconds(1000),
+                        int gridWidth = 64,
+                        int gridHeight = 36);
+
+    /**
+     * Returns true if the frame should be published. NV12, YUV420p, GRAY8, RAW8 and the planar/interleaved BGR/RGB
+     * types are compared on their first plane (or channel), frames of any other type are always published.
+     */
+    bool hasChanged(std::shared_ptr<dai::ImgFrame> inData);
+
+    // Mean absolute difference of the last compared frame, useful for tuning the threshold
+    float getLastDifference() const;
+
+   private:
+    bool computeSignature(std::shared_ptr<dai::ImgFrame> inData, std::vector<uint8_t>& signature) const;
+
+    const float _threshold;
+    const std::chrono::milliseconds _keepAlive;
+    const int _gridWidth, _gridHeight;
+    std::vector<uint8_t> _reference, _current;
+    std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration> _lastPublished;
+    bool _hasReference = false;
+    float _lastDifference = 0;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <depthai_bridge/LatencyHistogram.hpp>
+#include <mutex>
+#include <string>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Live counters of one BridgePublisher stream. BridgePublisher updates them in place with relaxed atomics, so when
+ * the record lives in a SharedStatsBlock, reading the stats from another process costs the publisher nothing extra.
+ */
+struct StreamStatsRecord {
+    static constexpr size_t kNameSize = 64;
+    static constexpr size_t kQueueDepthBuckets = 32;
+
+    StreamStatsRecord();
+
+    char name[kNameSize];
+    std::atomic<uint64_t> arrived, lostBeforeHost, received, missingAtReader, sequenceGaps;
+    std::atomic<uint64_t> filtered, noSubscriber, published;
+    // CPU time consumed by the thread publishing the stream, including its queue polling
+    std::atomic<uint64_t> cpuTimeNs;
+    // Conversion of a message, and device timestamp to publish
+    LatencyHistogram conversionTime, latency;
+    // Thread mode only: time from a message's timestamp until the reader takes it from the host queue, and the number of
+    // messages left queued behind it. The last depth bucket also counts every deeper queue.
+    LatencyHistogram queueWait;
+    std::array<std::atomic<uint64_t>, kQueueDepthBuckets> queueDepth;
+};
+
+/**
+ * POSIX shared memory block of StreamStatsRecords, read by the bridge_top tool.
+ * The exporting process creates /depthai_bridge_stats_<pid> and hands it to its publishers (BridgePublisher::exportStats),
+ * readers map it read only.
+ */
+class SharedStatsBlock {
+   public:
+    static constexpr const char* kNamePrefix = "/depthai_bridge_stats_";
+
+    /**
+     * Creates the block of this process with room for maxStreams streams. Throws std::runtime_error on failure.
+     */
+    explicit SharedStatsBlock(uint32_t maxStreams = 32);
+
+    /**
+     * Maps the block of another process read only. Throws std::runtime_error on failure.
+     */
+    explicit SharedStatsBlock(const std::string& name);
+
+    ~SharedStatsBlock();
+
+    SharedStatsBlock(const SharedStatsBlock&) = delete;
+    SharedStatsBlock& operator=(const SharedStatsBlock&) = delete;
+
+    /**
+     * Reserves the record of a new stream, thread safe. Throws if the block is full or mapped read only.
+     */
+    StreamStatsRecord* addStream(const std::string& name);
+
+    uint32_t getStreamCount() const;
+    const StreamStatsRecord& getStream(uint32_t index) const;
+    int getPid() const;
+    const std::string& getName() const;
+
+   private:
+    struct Header;
+
+    const std::string _name;
+    const bool _owner;
+    void* _base = nullptr;
+    size_t _mappedSize = 0;
+    Header* _header = nullptr;
+    StreamStatsRecord* _records = nullptr;
+    std::mutex _addMutex;
+};
+
+/**
+ * CPU time consumed by the calling thread so far.
+ */
+std::chrono::nanoseconds threadCpuTime();
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Fixed slot ring of frames in a POSIX shared memory segment, the data path of the "shm" image_transport plugins.
+ * The publishing process creates the segment and writes frames round robin, every slot is guarded by a sequence
+ * counter (odd while it is written) so readers in other processes can map it read only, look at a slot without
+ * copying and tell afterwards whether the writer reused the slot in the meantime.
+ */
+class ShmImageRing {
+   public:
+    struct Slot {
+        uint32_t index;
+        uint64_t sequence;
+    };
+
+    /**
+     * Creates the segment for writing, replacing a stale one of the same name. Throws std::runtime_error on failure.
+     */
+    ShmImageRing(const std::string& name, uint32_t slotCount, size_t slotSize);
+
+    /**
+     * Maps an existing segment read only. Throws std::runtime_error on failure.
+     */
+    explicit ShmImageRing(const std::string& name);
+
+    // Unmaps the segment, the writer also unlinks it. Readers keep their mapping until they are destroyed.
+    ~ShmImageRing();
+
+    ShmImageRing(const ShmImageRing&) = delete;
+    ShmImageRing& operator=(const ShmImageRing&) = delete;
+
+    /**
+     * Copies size bytes into the next slot, single writer only. Throws if size exceeds the slot size.
+     */
+    Slot write(const uint8_t* data, size_t size);
+
+    /**
+     * Zero copy view of the slot, nullptr if it no longer holds the given sequence. The memory may be overwritten
+     * while it is used, check isValid() once done with it and discard the result if it returns false.
+     */
+    const uint8_t* view(const Slot& slot, size_t& size) const;
+
+    bool isValid(const Slot& slot) const;
+
+    const std::string& getName() const;
+    size_t getSlotSize() const;
+
+   private:
+    struct SegmentHeader;
+    struct SlotHeader;
+
+    void map(int fd, size_t size, bool writable);
+    SlotHeader* slotHeader(uint32_t index) const;
+    uint8_t* slotData(uint32_t index) const;
+
+    const std::string _name;
+    const bool _writer;
+    uint8_t* _base = nullptr;
+    size_t _mappedSize = 0;
+    SegmentHeader* _header = nullptr;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <depthai_bridge/ShmImageRing.hpp>
+#include <memory>
+#include <mutex>
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/msg/shm_image_descriptor.hpp>
+    #include <image_transport/simple_publisher_plugin.hpp>
+    #include <image_transport/simple_subscriber_plugin.hpp>
+
+    #include "sensor_msgs/msg/image.hpp"
+#else
+    #include <depthai_ros_msgs/ShmImageDescriptor.h>
+    #include <image_transport/simple_publisher_plugin.h>
+    #include <image_transport/simple_subscriber_plugin.h>
+
+    #include "sensor_msgs/Image.h"
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiMsgs = depthai_ros_msgs::msg;
+namespace ImageMsgs = sensor_msgs::msg;
+using ShmImageDescriptorConstPtr = std::shared_ptr<const DepthaiMsgs::ShmImageDescriptor>;
+#else
+namespace DepthaiMsgs = depthai_ros_msgs;
+namespace ImageMsgs = sensor_msgs;
+using ShmImageDescriptorConstPtr = DepthaiMsgs::ShmImageDescriptor::ConstPtr;
+#endif
+
+/**
+ * "shm" image_transport publisher: copies every image into a ShmImageRing owned by the publishing process and
+ * sends only a ShmImageDescriptor, so subscribers on the same host skip the serialization of the pixels.
+ * Any image topic, including BridgePublisher's, offers it once the plugin is installed (<topic>/shm).
+ */
+class ShmPublisher : public image_transport::SimplePublisherPlugin<DepthaiMsgs::ShmImageDescriptor> {
+   public:
+    std::string getTransportName() const override;
+
+   protected:
+    void publish(const ImageMsgs::Image& message, const PublishFn& publishFn) const override;
+
+   private:
+    // Slots of the ring, a subscriber has to copy a frame out before this many newer frames are published
+    static constexpr uint32_t kSlotCount = 4;
+
+    mutable std::mutex _ringMutex;
+    mutable std::unique_ptr<ShmImageRing> _ring;
+    mutable uint32_t _generation = 0;
+};
+
+/**
+ * "shm" image_transport subscriber: maps the segment named in the descriptor and copies the slot into the image
+ * handed to the callback, frames whose slot was reused before the copy completed are dropped.
+ * Consumers that can work on the shared memory in place can use ShmImageRing::view() on the descriptor directly.
+ */
+class ShmSubscriber : public image_transport::SimpleSubscriberPlugin<DepthaiMsgs::ShmImageDescriptor> {
+   public:
+    std::string getTransportName() const override;
+
+   protected:
+    void internalCallback(const ShmImageDescriptorConstPtr& message, const Callback& userCallback) override;
+
+   private:
+    std::unique_ptr<ShmImageRing> _ring;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <depthai_bridge/CameraControlBridge.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <depthai_ros_msgs/srv/trigger_named.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <depthai_ros_msgs/TriggerNamed.h>
+    #include <ros/ros.h>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace DepthaiSrvs = depthai_ros_msgs::srv;
+#else
+namespace DepthaiSrvs = depthai_ros_msgs;
+#endif
+
+/**
+ * TriggerNamed service requesting a full resolution still from the camera through a CameraControlBridge.
+ * The service returns as soon as the capture command is queued (sent within one frame interval). The still
+ * itself arrives on the camera's still output and is published by its own BridgePublisher, on its own thread,
+ * so a slow 12MP conversion never holds up the preview stream.
+ */
+class StillCaptureService {
+   public:
+#ifdef IS_ROS2
+    StillCaptureService(std::shared_ptr<rclcpp::Node> node, std::string serviceName, std::shared_ptr<CameraControlBridge> controlBridge);
+#else
+    StillCaptureService(::ros::NodeHandle nh, std::string serviceName, std::shared_ptr<CameraControlBridge> controlBridge);
+#endif
+
+   private:
+#ifdef IS_ROS2
+    void captureCallback(const std::shared_ptr<DepthaiSrvs::TriggerNamed::Request> request, std::shared_ptr<DepthaiSrvs::TriggerNamed::Response> response);
+
+    std::shared_ptr<rclcpp::Node> _node;
+    rclcpp::Service<DepthaiSrvs::TriggerNamed>::SharedPtr _captureService;
+#else
+    bool captureCallback(DepthaiSrvs::TriggerNamed::Request& request, DepthaiSrvs::TriggerNamed::Response& response);
+
+    ::ros::NodeHandle _nh;
+    ::ros::ServiceServer _captureService;
+#endif
+    std::shared_ptr<CameraControlBridge> _controlBridge;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Immutable configuration of a converter that can be replaced while frames are being converted.
+ * The converter takes one snapshot per frame with load(), so a frame is never converted with half of an update.
+ * load() takes no lock: it counts itself as a reader and reads an atomic pointer. Updates serialize on a mutex of their
+ * own and keep replaced configs alive until they see no reader, so an update never waits for a conversion either.
+ * Copies of the owner start out with a copy of the current config.
+ */
+template <class Config>
+class SwappableConfig {
+   public:
+    /**
+     * Read access to one config, which stays valid for as long as the snapshot lives.
+     */
+    class Snapshot {
+       public:
+        Snapshot(Snapshot&& other) : _owner(other._owner), _config(other._config) {
+            other._owner = nullptr;
+        }
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+        Snapshot& operator=(Snapshot&&) = delete;
+        ~Snapshot() {
+            if(_owner) _owner->_readers.fetch_sub(1);
+        }
+
+        const Config& operator*() const {
+            return *_config;
+        }
+        const Config* operator->() const {
+            return _config;
+        }
+
+       private:
+        friend class SwappableConfig;
+        Snapshot(const SwappableConfig* owner, const Config* config) : _owner(owner), _config(config) {}
+
+        const SwappableConfig* _owner;
+        const Config* _config;
+    };
+
+    explicit SwappableConfig(Config config) : _config(new Config(std::move(config))) {}
+    SwappableConfig(const SwappableConfig& other) : SwappableConfig(*other.load()) {}
+    SwappableConfig& operator=(const SwappableConfig& other) {
+        if(this != &other) store(*other.load());
+        return *this;
+    }
+    ~SwappableConfig() {
+        delete _config.load();
+    }
+
+    Snapshot load() const {
+        // The reader is counted before the pointer is read, so an update that saw no readers after its swap knows
+        // nobody can still be holding the config it replaced
+        _readers.fetch_add(1);
+        return Snapshot(this, _config.load());
+    }
+
+    void store(Config config) {
+        std::lock_guard<std::mutex> lock(_updateMutex);
+        swap(new Config(std::move(config)));
+    }
+
+    /**
+     * Applies change(Config&) to a copy of the current config and swaps it in. Concurrent updates are applied one after another.
+     */
+    template <class Change>
+    void update(Change change) {
+        std::lock_guard<std::mutex> lock(_updateMutex);
+        std::unique_ptr<Config> next(new Config(*_config.load()));
+        change(*next);
+        swap(next.release());
+    }
+
+   private:
+    // Called with _updateMutex held
+    void swap(const Config* next) {
+        _retired.emplace_back(_config.exchange(next));
+        if(_readers.load() == 0) _retired.clear();
+    }
+
+    std::atomic<const Config*> _config;
+    mutable std::atomic<unsigned> _readers{0};
+    std::mutex _updateMutex;
+    // Replaced configs that a reader may still hold
+    std::vector<std::unique_ptr<const Config>> _retired;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace dai {
+
+namespace ros {
+
+/**
+ * Scheduling and memory options for a bridge thread, for bounded conversion latency on PREEMPT_RT kernels.
+ * Real time priority and mlockall need CAP_SYS_NICE / CAP_IPC_LOCK or matching rtprio / memlock limits.
+ * Only supported on Linux, requesting any of them elsewhere throws.
+ */
+struct ThreadOptions {
+    // SCHED_FIFO priority (1..99), 0 keeps the default scheduler
+    int fifoPriority = 0;
+    // CPUs the thread may run on, empty keeps the inherited affinity
+    std::vector<int> cpuAffinity;
+    // mlockall(MCL_CURRENT | MCL_FUTURE), process wide: pages are faulted in on allocation and never swapped out
+    bool lockMemory = false;
+    // Stack touched when the thread starts, so it does not page fault on the first deep call
+    size_t prefaultStackBytes = 0;
+
+    bool isDefault() const {
+        return fifoPriority == 0 && cpuAffinity.empty() && !lockMemory && prefaultStackBytes == 0;
+    }
+};
+
+/**
+ * Applies the options to the calling thread, throws std::runtime_error if the kernel refuses one of them.
+ */
+void applyThreadOptions(const ThreadOptions& options);
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <depthai_bridge/ImageConverter.hpp>
+
+#include "depthai/depthai.hpp"
+
+#ifdef IS_ROS2
+    #include <vision_msgs/msg/detection2_d_array.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <ros/ros.h>
+    #include <vision_msgs/Detection2DArray.h>
+
+    #include <boost/make_shared.hpp>
+    #include <boost/shared_ptr.hpp>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+namespace VisionMsgs = vision_msgs::msg;
+using Detection2DArrayPtr = VisionMsgs::Detection2DArray::SharedPtr;
+#else
+namespace VisionMsgs = vision_msgs;
+using Detection2DArrayPtr = VisionMsgs::Detection2DArray::Ptr;
+#endif
+
+/**
+ * Merges the detections of several NN tiles of the same frame into one Detection2DArray.
+ * Tile local boxes are remapped into full frame coordinates and deduplicated with a class aware NMS.
+ */
+class TiledDetectionMerger {
+   public:
+    /**
+     * @param tiles Normalized region of the full frame covered by each tile, in the same order as the
+     *              detections passed to toRosMsg().
+     * @param iouThreshold Boxes of the same label overlapping a higher scored box by more than this are dropped.
+     */
+    TiledDetectionMerger(std::string frameName, int width, int height, std::vector<dai::Rect> tiles, float iouThreshold = 0.5, bool normalized = false);
+
+    void toRosMsg(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData,
+                  VisionMsgs::Detection2DArray& opDetectionMsg,
+                  TimePoint tStamp,
+                  int32_t sequenceNum = -1);
+
+    void toRosMsg(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData, VisionMsgs::Detection2DArray& opDetectionMsg);
+
+    Detection2DArrayPtr toRosMsgPtr(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData);
+
+   private:
+    void remapTiles(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData);
+    void suppress();
+
+    uint32_t _sequenceNum;
+    int _width, _height;
+    const std::string _frameName;
+    bool _normalized;
+    const std::vector<dai::Rect> _tiles;
+    const float _iouThreshold;
+
+    // Structure of arrays of the remapped detections of the current frame, kept as members to reuse the allocations.
+    std::vector<float> _xMin, _yMin, _xMax, _yMax, _area, _score;
+    std::vector<uint32_t> _label, _order, _keep;
+    // Boxes already kept for the label being suppressed, contiguous so the IoU loop vectorizes.
+    std::vector<float> _keptXMin, _keptYMin, _keptXMax, _keptYMax, _keptArea;
+};
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+
+#ifdef IS_ROS2
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <ros/ros.h>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+using TimePoint = std::chrono::time_point<std::chrono::steady_clock, std::chrono::steady_clock::duration>;
+
+/**
+ * Converts a host synced depthai timestamp (steady clock) to the ROS clock, the same way the converters stamp their images.
+ */
+#ifdef IS_ROS2
+inline rclcpp::Time getFrameTime(TimePoint tstamp) {
+    auto rclNow = rclcpp::Clock().now();
+    auto steadyTime = std::chrono::steady_clock::now();
+    auto diffTime = steadyTime - tstamp;
+    return rclNow - diffTime;
+}
+#else
+inline ::ros::Time getFrameTime(TimePoint tstamp) {
+    auto rosNow = ::ros::Time::now();
+    auto steadyTime = std::chrono::steady_clock::now();
+    auto diffTime = steadyTime - tstamp;
+    long int nsec = rosNow.toNSec() - diffTime.count();
+    return rosNow.fromNSec(nsec);
+}
+#endif
+
+}  // namespace ros
+
+namespace rosBridge = ros;
+
+}  // namespace dai
@@ -0,0 +1,232 @@
+#include <algorithm>
+#include <apriltag/apriltag.h>
+#include <apriltag/apriltag_pose.h>
+#include <apriltag/common/homography.h>
+#include <apriltag/tag16h5.h>
+#include <apriltag/tag25h9.h>
+#include <apriltag/tag36h11.h>
+#include <apriltag/tagStandard41h12.h>
+#include <cmath>
+#include <depthai_bridge/AprilTagConverter.hpp>
+#include <vector>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+#ifdef IS_ROS2
+double intrinsic(const ImageMsgs::CameraInfo& cameraInfo, int index) {
+    return cameraInfo.k[index];
+}
+
+const std::vector<double>& distortion(const ImageMsgs::CameraInfo& cameraInfo) {
+    return cameraInfo.d;
+}
+#else
+double intrinsic(const ImageMsgs::CameraInfo& cameraInfo, int index) {
+    return cameraInfo.K[index];
+}
+
+const std::vector<double>& distortion(const ImageMsgs::CameraInfo& cameraInfo) {
+    return cameraInfo.D;
+}
+#endif
+
+// Corners and center where an ideal pinhole camera with the same intrinsics would have seen them, with the homography
+// recomputed from them, since the pose is estimated from the homography and the corners
+void undistortDetection(const apriltag_detection_t& detection,
+                        const cv::Matx33d& cameraMatrix,
+                        const std::vector<double>& distortion,
+                        bool fisheye,
+                        apriltag_detection_t& undistorted) {
+    std::vector<cv::Point2d> points(5), ideal;
+    for(int i = 0; i < 4; ++i) points[i] = cv::Point2d(detection.p[i][0], detection.p[i][1]);
+    points[4] = cv::Point2d(detection.c[0], detection.c[1]);
+    if(fisheye) {
+        cv::fisheye::undistortPoints(points, ideal, cameraMatrix, distortion, cv::noArray(), cameraMatrix);
+    } else {
+        cv::undistortPoints(points, ideal, cameraMatrix, distortion, cv::noArray(), cameraMatrix);
+    }
+
+    undistorted = detection;
+    double correspondences[4][4];
+    for(int i = 0; i < 4; ++i) {
+        // Tag frame corners in the order apriltag reports them: (-1, 1), (1, 1), (1, -1), (-1, -1)
+        correspondences[i][0] = (i == 0 || i == 3) ? -1 : 1;
+        correspondences[i][1] = (i == 0 || i == 1) ? 1 : -1;
+        correspondences[i][2] = undistorted.p[i][0] = ideal[i].x;
+        correspondences[i][3] = undistorted.p[i][1] = ideal[i].y;
+    }
+    undistorted.c[0] = ideal[4].x;
+    undistorted.c[1] = ideal[4].y;
+    undistorted.H = homography_compute2(correspondences);
+}
+
+}  // namespace
+
+AprilTagConverter::AprilTagConverter(
+    const std::string frameName, const ImageMsgs::CameraInfo& cameraInfo, double tagSize, const std::string& family, float quadDecimate, int threads)
+    : _frameName(frameName),
+      _familyName(family),
+      _tagSize(tagSize),
+      _fx(intrinsic(cameraInfo, 0)),
+      _fy(intrinsic(cameraInfo, 4)),
+      _cx(intrinsic(cameraInfo, 2)),
+      _cy(intrinsic(cameraInfo, 5)),
+      _width(cameraInfo.width),
+      _height(cameraInfo.height) {
+    if(_tagSize <= 0 || _fx <= 0 || _fy <= 0 || _width <= 0 || _height <= 0) {
+        throw std::runtime_error("AprilTagConverter needs a positive tag size and a valid camera info");
+    }
+    const auto& coefficients = distortion(cameraInfo);
+    if(std::any_of(coefficients.begin(), coefficients.end(), [](double c) { return c != 0.0; })) {
+        if(cameraInfo.distortion_model == "plumb_bob" || cameraInfo.distortion_model == "rational_polynomial") {
+            _distortion = coefficients;
+        } else if(cameraInfo.distortion_model == "equidistant" && coefficients.size() == 4) {
+            _distortion = coefficients;
+            _fisheye = true;
+        } else {
+            throw std::runtime_error("AprilTagConverter can not undistort the " + cameraInfo.distortion_model + " distortion model");
+        }
+    }
+    if(family == "tag36h11") {
+        _family = tag36h11_create();
+        _familyDestroy = tag36h11_destroy;
+    } else if(family == "tag25h9") {
+        _family = tag25h9_create();
+        _familyDestroy = tag25h9_destroy;
+    } else if(family == "tag16h5") {
+        _family = tag16h5_create();
+        _familyDestroy = tag16h5_destroy;
+    } else if(family == "tagStandard41h12") {
+        _family = tagStandard41h12_create();
+        _familyDestroy = tagStandard41h12_destroy;
+    } else {
+        throw std::runtime_error("AprilTagConverter does not know the tag family " + family);
+    }
+
+    _detector = apriltag_detector_create();
+    apriltag_detector_add_family(_detector, _family);
+    _detector->quad_decimate = std::max(1.0f, quadDecimate);
+    _detector->nthreads = std::max(1, threads);
+    _detector->refine_edges = true;
+}
+
+AprilTagConverter::~AprilTagConverter() {
+    apriltag_detector_destroy(_detector);
+    _familyDestroy(_family);
+}
+
+void AprilTagConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::AprilTagDetectionArray& outTagsMsg) {
+    outTagsMsg.header.frame_id = _frameName;
+    outTagsMsg.header.stamp = getFrameTime(inData->getTimestamp());
+#ifndef IS_ROS2
+    outTagsMsg.header.seq = inData->getSequenceNum();
+#endif
+    outTagsMsg.sequence_num = inData->getSequenceNum();
+    outTagsMsg.detections.clear();
+
+    switch(inData->getType()) {
+        case dai::RawImgFrame::Type::NV12:
+        case dai::RawImgFrame::Type::YUV420p:
+        case dai::RawImgFrame::Type::GRAY8:
+        case dai::RawImgFrame::Type::RAW8:
+            break;
+        default:
+            return;
+    }
+
+    // The luma plane leads all of the types above, so the detector can read it right out of the device buffer
+    const int width = inData->getWidth(), height = inData->getHeight();
+    image_u8_t luma = {width, height, width, inData->getData().data()};
+    zarray_t* detections = apriltag_detector_detect(_detector, &luma);
+
+    const double scaleX = static_cast<double>(width) / _width, scaleY = static_cast<double>(height) / _height;
+    outTagsMsg.detections.resize(zarray_size(detections));
+    for(int i = 0; i < zarray_size(detections); ++i) {
+        apriltag_detection_t* detection;
+        zarray_get(detections, i, &detection);
+        auto& tag = outTagsMsg.detections[i];
+        tag.family = _familyName;
+        tag.id = detection->id;
+        tag.hamming = detection->hamming;
+        tag.decision_margin = detection->decision_margin;
+        tag.center.x = detection->c[0];
+        tag.center.y = detection->c[1];
+        for(int corner = 0; corner < 4; ++corner) {
+            tag.corners[corner].x = detection->p[corner][0];
+            tag.corners[corner].y = detection->p[corner][1];
+        }
+
+        apriltag_detection_info_t info;
+        info.det = detection;
+        info.tagsize = _tagSize;
+        info.fx = _fx * scaleX;
+        info.fy = _fy * scaleY;
+        info.cx = _cx * scaleX;
+        info.cy = _cy * scaleY;
+        // The pose model is a pinhole camera, the published corners stay where they are in the image
+        apriltag_detection_t undistorted;
+        if(!_distortion.empty()) {
+            const cv::Matx33d cameraMatrix(info.fx, 0, info.cx, 0, info.fy, info.cy, 0, 0, 1);
+            undistortDetection(*detection, cameraMatrix, _distortion, _fisheye, undistorted);
+            info.det = &undistorted;
+        }
+        apriltag_pose_t pose;
+        tag.pose_error = estimate_tag_pose(&info, &pose);
+        if(info.det != detection) matd_destroy(undistorted.H);
+
+        tag.pose.position.x = MATD_EL(pose.t, 0, 0);
+        tag.pose.position.y = MATD_EL(pose.t, 1, 0);
+        tag.pose.position.z = MATD_EL(pose.t, 2, 0);
+        // Rotation matrix to quaternion, branching on the largest diagonal term to stay well conditioned
+        const double r00 = MATD_EL(pose.R, 0, 0), r01 = MATD_EL(pose.R, 0, 1), r02 = MATD_EL(pose.R, 0, 2);
+        const double r10 = MATD_EL(pose.R, 1, 0), r11 = MATD_EL(pose.R, 1, 1), r12 = MATD_EL(pose.R, 1, 2);
+        const double r20 = MATD_EL(pose.R, 2, 0), r21 = MATD_EL(pose.R, 2, 1), r22 = MATD_EL(pose.R, 2, 2);
+        const double trace = r00 + r11 + r22;
+        auto& q = tag.pose.orientation;
+        if(trace > 0) {
+            const double s = 2.0 * std::sqrt(trace + 1.0);
+            q.w = 0.25 * s;
+            q.x = (r21 - r12) / s;
+            q.y = (r02 - r20) / s;
+            q.z = (r10 - r01) / s;
+        } else if(r00 > r11 && r00 > r22) {
+            const double s = 2.0 * std::sqrt(1.0 + r00 - r11 - r22);
+            q.w = (r21 - r12) / s;
+            q.x = 0.25 * s;
+            q.y = (r01 + r10) / s;
+            q.z = (r02 + r20) / s;
+        } else if(r11 > r22) {
+            const double s = 2.0 * std::sqrt(1.0 + r11 - r00 - r22);
+            q.w = (r02 - r20) / s;
+            q.x = (r01 + r10) / s;
+            q.y = 0.25 * s;
+            q.z = (r12 + r21) / s;
+        } else {
+            const double s = 2.0 * std::sqrt(1.0 + r22 - r00 - r11);
+            q.w = (r10 - r01) / s;
+            q.x = (r02 + r20) / s;
+            q.y = (r12 + r21) / s;
+            q.z = 0.25 * s;
+        }
+        matd_destroy(pose.R);
+        matd_destroy(pose.t);
+    }
+    apriltag_detections_destroy(detections);
+}
+
+AprilTagDetectionArrayPtr AprilTagConverter::toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData) {
+#ifdef IS_ROS2
+    AprilTagDetectionArrayPtr ptr = std::make_shared<DepthaiMsgs::AprilTagDetectionArray>();
+#else
+    AprilTagDetectionArrayPtr ptr = boost::make_shared<DepthaiMsgs::AprilTagDetectionArray>();
+#endif
+    toRosMsg(inData, *ptr);
+    return ptr;
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <cmath>
+#include <depthai_bridge/AutoExposureController.hpp>
+
+namespace dai {
+
+namespace ros {
+
+AutoExposureController::AutoExposureController(std::shared_ptr<CameraControlBridge> controlBridge, Config config)
+    : _controlBridge(controlBridge), _config(config) {
+    _histogram.fill(0);
+}
+
+const std::array<uint32_t, 256>& AutoExposureController::getHistogram() const {
+    return _histogram;
+}
+
+void AutoExposureController::computeHistogram(const uint8_t* luma, int width, int height, int stride, int decimation, std::array<uint32_t, 256>& histogram) {
+    // Four interleaved partial histograms, so runs of equal pixels do not serialize on incrementing the same counter
+    std::array<uint32_t, 256 * 4> partial;
+    partial.fill(0);
+    const int step = std::max(decimation, 1);
+    for(int y = 0; y < height; y += step) {
+        const uint8_t* line = luma + static_cast<size_t>(y) * stride;
+        int x = 0;
+        for(; x + 3 * step < width; x += 4 * step) {
+            partial[line[x]]++;
+            partial[256 + line[x + step]]++;
+            partial[512 + line[x + 2 * step]]++;
+            partial[768 + line[x + 3 * step]]++;
+        }
+        for(; x < width; x += step) {
+            partial[line[x]]++;
+        }
+    }
+    for(int i = 0; i < 256; ++i) {
+        histogram[i] = partial[i] + partial[256 + i] + partial[512 + i] + partial[768 + i];
+    }
+}
+
+void AutoExposureController::processFrame(std::shared_ptr<dai::ImgFrame> inData) {
+    switch(inData->getType()) {
+        case dai::RawImgFrame::Type::NV12:
+        case dai::RawImgFrame::Type::YUV420p:
+        case dai::RawImgFrame::Type::GRAY8:
+        case dai::RawImgFrame::Type::RAW8:
+            break;
+        default:
+            throw std::runtime_error("AutoExposureController needs frames with an 8 bit luma plane (NV12, YUV420p, GRAY8, RAW8)");
+    }
+
+    // The luma plane is the start of the buffer for all supported types
+    const int width = inData->getWidth(), height = inData->getHeight();
+    computeHistogram(inData->getData().data(), width, height, width, _config.decimation, _histogram);
+
+    uint64_t count = 0, sum = 0;
+    for(int i = 0; i < 256; ++i) {
+        count += _histogram[i];
+        sum += static_cast<uint64_t>(i) * _histogram[i];
+    }
+    if(count == 0) return;
+    const float meanLuma = static_cast<float>(sum) / count;
+
+    uint32_t exposureUs = static_cast<uint32_t>(inData->getExposureTime().count());
+    uint32_t iso = static_cast<uint32_t>(inData->getSensitivity());
+    if(_requestedExposureUs != 0) {
+        // Frames captured before the last request took effect would make the loop overshoot
+        bool applied = std::abs(static_cast<float>(exposureUs) - _requestedExposureUs) <= 0.05f * _requestedExposureUs
+                       && std::abs(static_cast<float>(iso) - _requestedIso) <= 0.05f * _requestedIso;
+        if(!applied && ++_framesSinceRequest <= _config.settleFrames) return;
+        _requestedExposureUs = 0;
+    }
+
+    const float error = _config.targetLuma / std::max(meanLuma, 1.0f);
+    if(std::abs(error - 1.0f) < _config.deadband) return;
+
+    exposureUs = std::max(exposureUs, _config.minExposureUs);
+    iso = std::max(iso, _config.minIso);
+    const double totalExposure = static_cast<double>(exposureUs) * iso * std::pow(error, _config.gain);
+
+    // Prefer exposure time for low noise, raise ISO only once exposure time is maxed out
+    double newExposureUs = totalExposure / _config.minIso;
+    double newIso = _config.minIso;
+    if(newExposureUs > _config.maxExposureUs) {
+        newExposureUs = _config.maxExposureUs;
+        newIso = totalExposure / _config.maxExposureUs;
+    }
+    _requestedExposureUs = static_cast<uint32_t>(std::min(std::max(newExposureUs, static_cast<double>(_config.minExposureUs)), static_cast<double>(_config.maxExposureUs)));
+    _requestedIso = static_cast<uint32_t>(std::min(std::max(newIso, static_cast<double>(_config.minIso)), static_cast<double>(_config.maxIso)));
+    _framesSinceRequest = 0;
+    _controlBridge->setManualExposure(_requestedExposureUs, _requestedIso);
+}
+
+}  // namespace ros
+}  // namespace dai
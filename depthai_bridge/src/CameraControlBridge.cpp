@@ -0,0 +1,181 @@
+#include <depthai_bridge/CameraControlBridge.hpp>
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+CameraControlBridge::CameraControlBridge(std::shared_ptr<dai::DataInputQueue> controlQueue,
+                                         std::shared_ptr<rclcpp::Node> node,
+                                         std::string topicPrefix,
+                                         float frameRate)
+    : _controlQueue(controlQueue),
+      _frameInterval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / frameRate))),
+      _node(node),
+      _running(true) {
+    _autoFocusSub = _node->create_subscription<DepthaiMsgs::AutoFocusCtrl>(
+        topicPrefix + "/auto_focus_ctrl", 10, [this](const DepthaiMsgs::AutoFocusCtrl::SharedPtr msg) {
+            if(msg->auto_focus_mode > DepthaiMsgs::AutoFocusCtrl::AF_MODE_EDOF) {
+                RCLCPP_WARN(_node->get_logger(), "Ignoring AutoFocusCtrl with invalid auto_focus_mode %d", msg->auto_focus_mode);
+                return;
+            }
+            setAutoFocus(msg->auto_focus_mode, msg->trigger_auto_focus);
+        });
+    _exposureSub = _node->create_subscription<DepthaiMsgs::ExposureCtrl>(topicPrefix + "/exposure_ctrl", 10, [this](const DepthaiMsgs::ExposureCtrl::SharedPtr msg) {
+        if(msg->auto_exposure) {
+            setAutoExposure();
+        } else {
+            setManualExposure(msg->exposure_time_us, msg->sensitivity_iso);
+        }
+    });
+    _whiteBalanceSub = _node->create_subscription<DepthaiMsgs::WhiteBalanceCtrl>(
+        topicPrefix + "/white_balance_ctrl", 10, [this](const DepthaiMsgs::WhiteBalanceCtrl::SharedPtr msg) {
+            if(msg->auto_white_balance) {
+                setAutoWhiteBalance();
+            } else {
+                setManualWhiteBalance(msg->color_temperature);
+            }
+        });
+    _sendingThread = std::thread(&CameraControlBridge::sendingLoop, this);
+}
+#else
+CameraControlBridge::CameraControlBridge(std::shared_ptr<dai::DataInputQueue> controlQueue, ::ros::NodeHandle nh, std::string topicPrefix, float frameRate)
+    : _controlQueue(controlQueue),
+      _frameInterval(std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.0f / frameRate))),
+      _nh(nh),
+      _running(true) {
+    _autoFocusSub = _nh.subscribe<DepthaiMsgs::AutoFocusCtrl>(
+        topicPrefix + "/auto_focus_ctrl", 10, [this](const DepthaiMsgs::AutoFocusCtrl::ConstPtr& msg) {
+            if(msg->auto_focus_mode > DepthaiMsgs::AutoFocusCtrl::AF_MODE_EDOF) {
+                ROS_WARN_STREAM("Ignoring AutoFocusCtrl with invalid auto_focus_mode " << static_cast<int>(msg->auto_focus_mode));
+                return;
+            }
+            setAutoFocus(msg->auto_focus_mode, msg->trigger_auto_focus);
+        });
+    _exposureSub = _nh.subscribe<DepthaiMsgs::ExposureCtrl>(topicPrefix + "/exposure_ctrl", 10, [this](const DepthaiMsgs::ExposureCtrl::ConstPtr& msg) {
+        if(msg->auto_exposure) {
+            setAutoExposure();
+        } else {
+            setManualExposure(msg->exposure_time_us, msg->sensitivity_iso);
+        }
+    });
+    _whiteBalanceSub = _nh.subscribe<DepthaiMsgs::WhiteBalanceCtrl>(
+        topicPrefix + "/white_balance_ctrl", 10, [this](const DepthaiMsgs::WhiteBalanceCtrl::ConstPtr& msg) {
+            if(msg->auto_white_balance) {
+                setAutoWhiteBalance();
+            } else {
+                setManualWhiteBalance(msg->color_temperature);
+            }
+        });
+    _sendingThread = std::thread(&CameraControlBridge::sendingLoop, this);
+}
+#endif
+
+CameraControlBridge::~CameraControlBridge() {
+    {
+        // Under the mutex, so the loop can not miss the notification between checking _running and waiting
+        std::lock_guard<std::mutex> lock(_mutex);
+        _running = false;
+    }
+    _cv.notify_one();
+    if(_sendingThread.joinable()) _sendingThread.join();
+}
+
+void CameraControlBridge::setAutoFocus(uint8_t autoFocusMode, bool triggerAutoFocus) {
+    if(autoFocusMode > DepthaiMsgs::AutoFocusCtrl::AF_MODE_EDOF) {
+        throw std::runtime_error("Invalid auto focus mode " + std::to_string(autoFocusMode));
+    }
+    update([&](PendingControl& pending) {
+        pending.autoFocusModeSet = true;
+        // AutoFocusCtrl starts at AUTO while the depthai enum starts at OFF
+        pending.autoFocusMode = static_cast<dai::CameraControl::AutoFocusMode>(autoFocusMode + 1);
+        pending.autoFocusTrigger = pending.autoFocusTrigger || triggerAutoFocus;
+    });
+}
+
+void CameraControlBridge::setManualExposure(uint32_t exposureTimeUs, uint32_t sensitivityIso) {
+    update([&](PendingControl& pending) {
+        pending.exposureSet = true;
+        pending.autoExposure = false;
+        pending.exposureTimeUs = exposureTimeUs;
+        pending.sensitivityIso = sensitivityIso;
+    });
+}
+
+void CameraControlBridge::setAutoExposure() {
+    update([](PendingControl& pending) {
+        pending.exposureSet = true;
+        pending.autoExposure = true;
+    });
+}
+
+void CameraControlBridge::setManualWhiteBalance(uint32_t colorTemperature) {
+    update([&](PendingControl& pending) {
+        pending.whiteBalanceSet = true;
+        pending.autoWhiteBalance = false;
+        pending.colorTemperature = colorTemperature;
+    });
+}
+
+void CameraControlBridge::setAutoWhiteBalance() {
+    update([](PendingControl& pending) {
+        pending.whiteBalanceSet = true;
+        pending.autoWhiteBalance = true;
+    });
+}
+
+void CameraControlBridge::captureStill() {
+    update([](PendingControl& pending) { pending.captureStill = true; });
+}
+
+void CameraControlBridge::sendingLoop() {
+    auto lastSent = std::chrono::steady_clock::now() - _frameInterval;
+    while(_running) {
+        PendingControl pending;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this]() { return !_running || !_pending.empty(); });
+            if(!_running) break;
+
+            // Everything arriving until one frame interval after the previous send goes out together
+            _cv.wait_until(lock, lastSent + _frameInterval, [this]() { return !_running.load(); });
+            if(!_running) break;
+
+            pending = _pending;
+            _pending = PendingControl();
+        }
+
+        auto control = std::make_shared<dai::CameraControl>();
+        if(pending.autoFocusModeSet) control->setAutoFocusMode(pending.autoFocusMode);
+        if(pending.autoFocusTrigger) control->setAutoFocusTrigger();
+        if(pending.exposureSet) {
+            if(pending.autoExposure) {
+                control->setAutoExposureEnable();
+            } else {
+                control->setManualExposure(pending.exposureTimeUs, pending.sensitivityIso);
+            }
+        }
+        if(pending.whiteBalanceSet) {
+            if(pending.autoWhiteBalance) {
+                control->setAutoWhiteBalanceMode(dai::CameraControl::AutoWhiteBalanceMode::AUTO);
+            } else {
+                control->setManualWhiteBalance(pending.colorTemperature);
+            }
+        }
+        if(pending.captureStill) control->setCaptureStill(true);
+        try {
+            _controlQueue->send(control);
+        } catch(const std::exception& e) {
+            // E.g. the device went away, an exception escaping the thread would terminate the process
+#ifdef IS_ROS2
+            RCLCPP_ERROR(_node->get_logger(), "Sending camera control failed: %s", e.what());
+#else
+            ROS_ERROR_STREAM("Sending camera control failed: " << e.what());
+#endif
+        }
+        lastSent = std::chrono::steady_clock::now();
+    }
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,34 @@
+#include <depthai_bridge/CameraMetadataConverter.hpp>
+
+namespace dai {
+
+namespace ros {
+
+CameraMetadataConverter::CameraMetadataConverter(const std::string frameName) : _frameName(frameName) {}
+
+void CameraMetadataConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::CameraMetadata& outMetadataMsg) {
+    outMetadataMsg.header.frame_id = _frameName;
+    outMetadataMsg.header.stamp = getFrameTime(inData->getTimestamp());
+#ifndef IS_ROS2
+    outMetadataMsg.header.seq = inData->getSequenceNum();
+#endif
+
+    outMetadataMsg.sequence_num = inData->getSequenceNum();
+    outMetadataMsg.exposure_time_us = static_cast<uint32_t>(inData->getExposureTime().count());
+    outMetadataMsg.sensitivity_iso = inData->getSensitivity();
+    outMetadataMsg.lens_position = inData->getLensPosition();
+    outMetadataMsg.color_temperature = inData->getColorTemperature();
+}
+
+CameraMetadataPtr CameraMetadataConverter::toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData) {
+#ifdef IS_ROS2
+    CameraMetadataPtr ptr = std::make_shared<DepthaiMsgs::CameraMetadata>();
+#else
+    CameraMetadataPtr ptr = boost::make_shared<DepthaiMsgs::CameraMetadata>();
+#endif
+    toRosMsg(inData, *ptr);
+    return ptr;
+}
+
+}  // namespace ros
+}  // namespace dai
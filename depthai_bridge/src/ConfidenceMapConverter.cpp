@@ -0,0 +1,96 @@
+#include <depthai_bridge/ConfidenceMapConverter.hpp>
+
+namespace dai {
+
+namespace ros {
+
+ConfidenceMapConverter::ConfidenceMapConverter(const std::string frameName, uint8_t confidenceThreshold)
+    : _frameName(frameName), _confidenceThreshold(confidenceThreshold) {}
+
+void ConfidenceMapConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::Image& outImageMsg) {
+    outImageMsg.header.frame_id = _frameName;
+    outImageMsg.header.stamp = getFrameTime(inData->getTimestamp());
+#ifndef IS_ROS2
+    outImageMsg.header.seq = inData->getSequenceNum();
+#endif
+
+    outImageMsg.encoding = sensor_msgs::image_encodings::MONO8;
+    outImageMsg.width = inData->getWidth();
+    outImageMsg.height = inData->getHeight();
+    outImageMsg.step = inData->getWidth();
+    outImageMsg.is_bigendian = false;
+    outImageMsg.data.assign(inData->getData().begin(), inData->getData().end());
+}
+
+void ConfidenceMapConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> depthData,
+                                      std::shared_ptr<dai::ImgFrame> confidenceData,
+                                      ImageMsgs::Image& outDepthMsg,
+                                      ImageMsgs::Image& outConfidenceMsg) {
+    checkPair(*depthData, *confidenceData);
+
+    // Both frames share the device timestamp, stamp once so the two messages carry the exact same header
+    toRosMsg(confidenceData, outConfidenceMsg);
+    outDepthMsg.header = outConfidenceMsg.header;
+    outDepthMsg.encoding = sensor_msgs::image_encodings::TYPE_16UC1;
+    outDepthMsg.width = depthData->getWidth();
+    outDepthMsg.height = depthData->getHeight();
+    outDepthMsg.step = depthData->getWidth() * sizeof(uint16_t);
+    outDepthMsg.is_bigendian = false;
+
+    const size_t numPixels = depthData->getWidth() * depthData->getHeight();
+    outDepthMsg.data.resize(numPixels * sizeof(uint16_t));
+    const uint16_t* depth = reinterpret_cast<const uint16_t*>(depthData->getData().data());
+    const uint8_t* confidence = confidenceData->getData().data();
+    uint16_t* dst = reinterpret_cast<uint16_t*>(outDepthMsg.data.data());
+    const uint8_t threshold = _confidenceThreshold;
+
+    // Masking is fused into the copy to the message, a single branch-free pass the compiler vectorizes
+    for(size_t i = 0; i < numPixels; ++i) {
+        uint16_t value = depth[i];
+        dst[i] = confidence[i] > threshold ? 0 : value;
+    }
+}
+
+ImagePtr ConfidenceMapConverter::toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData) {
+#ifdef IS_ROS2
+    ImagePtr ptr = std::make_shared<ImageMsgs::Image>();
+#else
+    ImagePtr ptr = boost::make_shared<ImageMsgs::Image>();
+#endif
+    toRosMsg(inData, *ptr);
+    return ptr;
+}
+
+void ConfidenceMapConverter::maskDepth(dai::ImgFrame& depthData, dai::ImgFrame& confidenceData, uint8_t confidenceThreshold) {
+    checkPair(depthData, confidenceData);
+
+    const size_t numPixels = depthData.getWidth() * depthData.getHeight();
+    uint16_t* depth = reinterpret_cast<uint16_t*>(depthData.getData().data());
+    const uint8_t* confidence = confidenceData.getData().data();
+    for(size_t i = 0; i < numPixels; ++i) {
+        depth[i] = confidence[i] > confidenceThreshold ? 0 : depth[i];
+    }
+}
+
+void ConfidenceMapConverter::checkPair(dai::ImgFrame& depthData, dai::ImgFrame& confidenceData) {
+    if(depthData.getType() != dai::RawImgFrame::Type::RAW16) {
+        throw std::runtime_error("ConfidenceMapConverter expects RAW16 depth frames");
+    }
+    if(confidenceData.getType() != dai::RawImgFrame::Type::RAW8 && confidenceData.getType() != dai::RawImgFrame::Type::GRAY8) {
+        throw std::runtime_error("ConfidenceMapConverter expects RAW8 or GRAY8 confidence maps");
+    }
+    if(depthData.getWidth() != confidenceData.getWidth() || depthData.getHeight() != confidenceData.getHeight()) {
+        throw std::runtime_error("Depth frame and confidence map sizes do not match");
+    }
+    // The masking loops index every pixel of both buffers, a truncated frame must not get that far
+    const size_t numPixels = static_cast<size_t>(depthData.getWidth()) * depthData.getHeight();
+    if(depthData.getData().size() < numPixels * sizeof(uint16_t) || confidenceData.getData().size() < numPixels) {
+        throw std::runtime_error("Depth frame or confidence map holds less data than its size needs");
+    }
+    if(depthData.getSequenceNum() != confidenceData.getSequenceNum()) {
+        throw std::runtime_error("Depth frame and confidence map belong to different frames");
+    }
+}
+
+}  // namespace ros
+}  // namespace dai
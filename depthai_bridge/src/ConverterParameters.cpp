@@ -0,0 +1,191 @@
+#include <depthai_bridge/ConverterParameters.hpp>
+#include <stdexcept>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+std::string enhancementName(ImageConverter::Enhancement enhancement) {
+    switch(enhancement) {
+        case ImageConverter::Enhancement::EQUALIZE:
+            return "equalize";
+        case ImageConverter::Enhancement::CLAHE:
+            return "clahe";
+        default:
+            return "none";
+    }
+}
+
+ImageConverter::Enhancement enhancementFromName(const std::string& name) {
+    if(name == "none") return ImageConverter::Enhancement::NONE;
+    if(name == "equalize") return ImageConverter::Enhancement::EQUALIZE;
+    if(name == "clahe") return ImageConverter::Enhancement::CLAHE;
+    throw std::runtime_error("enhancement has to be one of none, equalize, clahe");
+}
+
+}  // namespace
+
+template <class Converter>
+std::shared_ptr<typename Converter::Config> ConverterParameters::addBinding(const std::string& prefix, Converter& converter) {
+    auto staged = std::make_shared<typename Converter::Config>(converter.getConfig());
+    Converter* target = &converter;
+    // Only the parameters write the config, staging from it and replacing it is not racing anyone
+    _bindings.push_back(Binding{prefix,
+                                [target, staged]() { *staged = target->getConfig(); },
+                                [staged]() { Converter::validate(*staged); },
+                                [target, staged]() { target->setConfig(*staged); }});
+    return staged;
+}
+
+void ConverterParameters::commitOverrides() {
+    _bindings.back().validate();
+    _bindings.back().commit();
+}
+
+#ifdef IS_ROS2
+ConverterParameters::ConverterParameters(std::shared_ptr<rclcpp::Node> node) : _node(node) {
+    _callbackHandle = _node->add_on_set_parameters_callback(std::bind(&ConverterParameters::onSetParameters, this, std::placeholders::_1));
+}
+
+template <class T>
+void ConverterParameters::declare(const std::string& name, const T& initial, std::function<void(const T&)> stage) {
+    // Returns an override from the command line or a parameter file if there is one
+    const T value = _node->declare_parameter(name, initial);
+    if(!(value == initial)) stage(value);
+    _handlers[name] = Handler{_bindings.size() - 1, [stage](const rclcpp::Parameter& parameter) { stage(parameter.get_value<T>()); }};
+}
+
+rcl_interfaces::msg::SetParametersResult ConverterParameters::onSetParameters(const std::vector<rclcpp::Parameter>& parameters) {
+    rcl_interfaces::msg::SetParametersResult result;
+    result.successful = true;
+    // Nothing reaches a converter before every parameter of the set was staged and every staged config validated.
+    // Only the bindings the set touches are restaged: declare_parameter() calls back here while bind() is still
+    // staging the overrides of the last binding.
+    std::vector<bool> changed(_bindings.size(), false);
+    for(const auto& parameter : parameters) {
+        auto handler = _handlers.find(parameter.get_name());
+        if(handler == _handlers.end()) continue;
+        const size_t binding = handler->second.binding;
+        if(!changed[binding]) {
+            _bindings[binding].stage();
+            changed[binding] = true;
+        }
+        try {
+            handler->second.stage(parameter);
+        } catch(const std::exception& e) {
+            result.successful = false;
+            result.reason = parameter.get_name() + ": " + e.what();
+            return result;
+        }
+    }
+    for(size_t i = 0; i < _bindings.size(); ++i) {
+        if(!changed[i]) continue;
+        try {
+            _bindings[i].validate();
+        } catch(const std::exception& e) {
+            result.successful = false;
+            result.reason = _bindings[i].prefix + ": " + e.what();
+            return result;
+        }
+    }
+    for(size_t i = 0; i < _bindings.size(); ++i) {
+        if(changed[i]) _bindings[i].commit();
+    }
+    return result;
+}
+
+std::string ConverterParameters::parameterName(const std::string& prefix, const std::string& name) const {
+    return prefix.empty() ? name : prefix + "." + name;
+}
+#else
+ConverterParameters::ConverterParameters(::ros::NodeHandle nh, std::chrono::milliseconds pollPeriod) : _nh(nh) {
+    _pollTimer = _nh.createWallTimer(::ros::WallDuration(pollPeriod.count() / 1000.0), [this](const ::ros::WallTimerEvent&) { poll(); });
+}
+
+template <class T>
+void ConverterParameters::declare(const std::string& name, const T& initial, std::function<void(const T&)> stage) {
+    T value = initial;
+    if(_nh.getParam(name, value)) {
+        if(!(value == initial)) stage(value);
+    } else {
+        _nh.setParam(name, initial);
+    }
+
+    // A rejected value is not retried until it changes again
+    auto seen = std::make_shared<T>(value);
+    _pollers.push_back(Poller{_bindings.size() - 1, [this, name, stage, seen]() {
+                                  T current;
+                                  if(!_nh.getParamCached(name, current) || current == *seen) return false;
+                                  *seen = current;
+                                  stage(current);
+                                  return true;
+                              }});
+}
+
+void ConverterParameters::poll() {
+    std::vector<bool> changed(_bindings.size(), false);
+    for(auto& binding : _bindings) binding.stage();
+    for(auto& poller : _pollers) {
+        if(poller.stageChanged()) changed[poller.binding] = true;
+    }
+    for(size_t i = 0; i < _bindings.size(); ++i) {
+        if(!changed[i]) continue;
+        try {
+            _bindings[i].validate();
+        } catch(const std::runtime_error& e) {
+            ROS_WARN_STREAM("Ignoring the parameter changes of " << _bindings[i].prefix << ": " << e.what());
+            continue;
+        }
+        _bindings[i].commit();
+    }
+}
+
+std::string ConverterParameters::parameterName(const std::string& prefix, const std::string& name) const {
+    return prefix.empty() ? name : prefix + "/" + name;
+}
+#endif
+
+void ConverterParameters::bind(const std::string& prefix, ImageConverter& converter) {
+    auto staged = addBinding(prefix, converter);
+    const auto config = *staged;
+    declare<std::string>(parameterName(prefix, "frame_id"), config.frameName, [staged](const std::string& frameName) { staged->frameName = frameName; });
+    declare<bool>(parameterName(prefix, "mono_output"), config.monoOutput, [staged](const bool& mono) { staged->monoOutput = mono; });
+    declare<int>(parameterName(prefix, "downscale"), static_cast<int>(config.downscale), [staged](const int& factor) {
+        if(factor < 1) throw std::runtime_error("downscale has to be at least 1");
+        staged->downscale = static_cast<unsigned>(factor);
+    });
+    declare<std::string>(parameterName(prefix, "enhancement"), enhancementName(config.enhancement), [staged](const std::string& name) {
+        staged->enhancement = enhancementFromName(name);
+    });
+    declare<double>(parameterName(prefix, "clahe_clip_limit"), config.claheClipLimit, [staged](const double& clipLimit) {
+        staged->claheClipLimit = clipLimit;
+    });
+    declare<int>(parameterName(prefix, "clahe_tiles"), config.claheTiles, [staged](const int& tiles) { staged->claheTiles = tiles; });
+    commitOverrides();
+}
+
+void ConverterParameters::bind(const std::string& prefix, DisparityConverter& converter) {
+    auto staged = addBinding(prefix, converter);
+    const auto config = *staged;
+    declare<std::string>(parameterName(prefix, "frame_id"), config.frameName, [staged](const std::string& frameName) { staged->frameName = frameName; });
+    declare<double>(parameterName(prefix, "focal_length"), config.focalLength, [staged](const double& focalLength) { staged->focalLength = focalLength; });
+    declare<double>(parameterName(prefix, "baseline"), config.baseline, [staged](const double& baseline) { staged->baseline = baseline; });
+    declare<double>(parameterName(prefix, "min_depth"), config.minDepth, [staged](const double& minDepth) { staged->minDepth = minDepth; });
+    declare<double>(parameterName(prefix, "max_depth"), config.maxDepth, [staged](const double& maxDepth) { staged->maxDepth = maxDepth; });
+    commitOverrides();
+}
+
+void ConverterParameters::bind(const std::string& prefix, ImgDetectionConverter& converter) {
+    auto staged = addBinding(prefix, converter);
+    const auto config = *staged;
+    declare<std::string>(parameterName(prefix, "frame_id"), config.frameName, [staged](const std::string& frameName) { staged->frameName = frameName; });
+    declare<int>(parameterName(prefix, "width"), config.width, [staged](const int& width) { staged->width = width; });
+    declare<int>(parameterName(prefix, "height"), config.height, [staged](const int& height) { staged->height = height; });
+    declare<bool>(parameterName(prefix, "normalized"), config.normalized, [staged](const bool& normalized) { staged->normalized = normalized; });
+    commitOverrides();
+}
+
+}  // namespace ros
+}  // namespace dai
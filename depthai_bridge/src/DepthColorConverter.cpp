@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <depthai_bridge/DepthColorConverter.hpp>
+
+namespace dai {
+
+namespace ros {
+
+DepthColorConverter::DepthColorConverter(const std::string frameName, Source source, float minValue, float maxValue, ColorMap colorMap)
+    : _frameName(frameName) {
+    if(maxValue <= minValue) {
+        throw std::runtime_error("DepthColorConverter needs maxValue to be greater than minValue");
+    }
+
+    cv::Mat ramp(1, 256, CV_8UC1), palette;
+    for(int i = 0; i < 256; ++i) {
+        ramp.at<uint8_t>(0, i) = static_cast<uint8_t>(i);
+    }
+    int cvColorMap = cv::COLORMAP_JET;
+#if CV_VERSION_MAJOR > 4 || (CV_VERSION_MAJOR == 4 && CV_VERSION_MINOR >= 2)
+    if(colorMap == ColorMap::TURBO) cvColorMap = cv::COLORMAP_TURBO;
+#endif
+    cv::applyColorMap(ramp, palette, cvColorMap);
+
+    _lut.resize(65536 * 3);
+    const float scale = 255.0f / (maxValue - minValue);
+    for(int value = 0; value < 65536; ++value) {
+        uint8_t* entry = &_lut[value * 3];
+        if(value == 0) {
+            entry[0] = entry[1] = entry[2] = 0;
+            continue;
+        }
+        float t = std::min(std::max((value - minValue) * scale, 0.0f), 255.0f);
+        // Disparity grows when getting closer while depth shrinks, flip depth so near is at the hot end for both
+        int index = static_cast<int>(source == Source::DEPTH ? 255.0f - t : t);
+        const cv::Vec3b& color = palette.at<cv::Vec3b>(0, index);
+        entry[0] = color[0];
+        entry[1] = color[1];
+        entry[2] = color[2];
+    }
+}
+
+void DepthColorConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::Image& outImageMsg) {
+    outImageMsg.header.frame_id = _frameName;
+    outImageMsg.header.stamp = getFrameTime(inData->getTimestamp());
+#ifndef IS_ROS2
+    outImageMsg.header.seq = inData->getSequenceNum();
+#endif
+
+    const size_t width = inData->getWidth(), height = inData->getHeight();
+    const size_t numPixels = width * height;
+    outImageMsg.encoding = sensor_msgs::image_encodings::BGR8;
+    outImageMsg.width = width;
+    outImageMsg.height = height;
+    outImageMsg.step = width * 3;
+    outImageMsg.is_bigendian = false;
+    outImageMsg.data.resize(numPixels * 3);
+
+    // The table is applied straight into the message buffer, no intermediate cv::Mat
+    const uint8_t* lut = _lut.data();
+    uint8_t* dst = outImageMsg.data.data();
+    if(inData->getType() == dai::RawImgFrame::Type::RAW8 || inData->getType() == dai::RawImgFrame::Type::GRAY8) {
+        const uint8_t* src = inData->getData().data();
+        for(size_t i = 0; i < numPixels; ++i) {
+            const uint8_t* color = lut + src[i] * 3;
+            dst[i * 3 + 0] = color[0];
+            dst[i * 3 + 1] = color[1];
+            dst[i * 3 + 2] = color[2];
+        }
+    } else if(inData->getType() == dai::RawImgFrame::Type::RAW16) {
+        const uint16_t* src = reinterpret_cast<const uint16_t*>(inData->getData().data());
+        for(size_t i = 0; i < numPixels; ++i) {
+            const uint8_t* color = lut + src[i] * 3;
+            dst[i * 3 + 0] = color[0];
+            dst[i * 3 + 1] = color[1];
+            dst[i * 3 + 2] = color[2];
+        }
+    } else {
+        throw std::runtime_error("DepthColorConverter expects RAW8 disparity or RAW16 disparity/depth frames");
+    }
+}
+
+ImagePtr DepthColorConverter::toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData) {
+#ifdef IS_ROS2
+    ImagePtr ptr = std::make_shared<ImageMsgs::Image>();
+#else
+    ImagePtr ptr = boost::make_shared<ImageMsgs::Image>();
+#endif
+    toRosMsg(inData, *ptr);
+    return ptr;
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <depthai_bridge/DepthSectorConverter.hpp>
+#include <limits>
+
+namespace dai {
+
+namespace ros {
+
+DepthSectorConverter::DepthSectorConverter(const std::string frameName,
+                                           const ImageMsgs::CameraInfo& cameraInfo,
+                                           int numSectors,
+                                           float minDepth,
+                                           float maxDepth,
+                                           float percentile,
+                                           int rowBegin,
+                                           int rowEnd)
+    : _frameName(frameName),
+      _width(cameraInfo.width),
+      _numSectors(numSectors),
+      _minDepth(minDepth),
+      _maxDepth(maxDepth),
+      _percentile(percentile),
+      _rowBegin(rowBegin),
+      _rowEnd(rowEnd) {
+    if(_numSectors <= 0 || _width <= 0) {
+        throw std::runtime_error("DepthSectorConverter needs at least one sector and a valid camera info width");
+    }
+    if(!(_percentile >= 0.0f && _percentile <= 1.0f)) {
+        throw std::runtime_error("DepthSectorConverter percentile has to be within [0, 1], got " + std::to_string(_percentile));
+    }
+#ifdef IS_ROS2
+    const double fx = cameraInfo.k[0], cx = cameraInfo.k[2];
+#else
+    const double fx = cameraInfo.K[0], cx = cameraInfo.K[2];
+#endif
+    if(!(fx > 0)) {
+        throw std::runtime_error("DepthSectorConverter needs a camera info with a positive focal length");
+    }
+    // Also rejects NaN, which the millimeter conversion below must not see
+    if(!(_maxDepth > _minDepth)) {
+        throw std::runtime_error("DepthSectorConverter needs minDepth < maxDepth, got " + std::to_string(_minDepth) + " and " + std::to_string(_maxDepth));
+    }
+
+    _minDepthMm = static_cast<uint16_t>(std::min(std::max(minDepth * 1000.0f, 1.0f), 65534.0f));
+    const uint16_t maxDepthMm = static_cast<uint16_t>(std::min(maxDepth * 1000.0f, 65534.0f));
+    // Checked again in millimeters, the unsigned range would otherwise wrap around and accept every pixel
+    if(maxDepthMm <= _minDepthMm) {
+        throw std::runtime_error("DepthSectorConverter depth range is empty in millimeters, got " + std::to_string(_minDepth) + " to "
+                                 + std::to_string(_maxDepth) + " m");
+    }
+    _depthRangeMm = maxDepthMm - _minDepthMm;
+
+    _angleMin = std::atan((0 - cx) / fx);
+    _angleIncrement = (std::atan((_width - cx) / fx) - _angleMin) / _numSectors;
+
+    _columnSector.resize(_width);
+    for(int u = 0; u < _width; ++u) {
+        double angle = std::atan((u + 0.5 - cx) / fx);
+        int sector = static_cast<int>((angle - _angleMin) / _angleIncrement);
+        _columnSector[u] = static_cast<uint16_t>(std::min(std::max(sector, 0), _numSectors - 1));
+    }
+    _columnMin.resize(_width);
+    _sectorColumns.resize(_numSectors);
+    for(auto& columns : _sectorColumns) {
+        columns.reserve(_width / _numSectors + 1);
+    }
+}
+
+void DepthSectorConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::DepthSectors& outSectorsMsg) {
+    if(inData->getType() != dai::RawImgFrame::Type::RAW16 || static_cast<int>(inData->getWidth()) != _width) {
+        throw std::runtime_error("DepthSectorConverter expects RAW16 depth frames matching the camera info width");
+    }
+
+    outSectorsMsg.header.frame_id = _frameName;
+    outSectorsMsg.header.stamp = getFrameTime(inData->getTimestamp());
+#ifndef IS_ROS2
+    outSectorsMsg.header.seq = inData->getSequenceNum();
+#endif
+    outSectorsMsg.angle_min = _angleMin;
+    outSectorsMsg.angle_increment = _angleIncrement;
+    outSectorsMsg.range_min = _minDepth;
+    outSectorsMsg.range_max = _maxDepth;
+    outSectorsMsg.percentile = _percentile;
+
+    const int height = inData->getHeight();
+    const int rowEnd = _rowEnd < 0 ? height : std::min(_rowEnd, height);
+    const uint16_t* depth = reinterpret_cast<const uint16_t*>(inData->getData().data());
+    const uint16_t minDepthMm = _minDepthMm;
+    uint16_t* columnMin = _columnMin.data();
+
+    // Vertical min reduction into one value per column. Subtracting the minimum depth wraps invalid (0) and too close
+    // pixels around to large values, so a plain unsigned min skips them and the loop vectorizes without branches.
+    std::fill(_columnMin.begin(), _columnMin.end(), std::numeric_limits<uint16_t>::max());
+    for(int row = std::max(_rowBegin, 0); row < rowEnd; ++row) {
+        const uint16_t* line = depth + static_cast<size_t>(row) * _width;
+        for(int u = 0; u < _width; ++u) {
+            uint16_t offsetDepth = static_cast<uint16_t>(line[u] - minDepthMm);
+            columnMin[u] = std::min(columnMin[u], offsetDepth);
+        }
+    }
+
+    for(auto& columns : _sectorColumns) {
+        columns.clear();
+    }
+    for(int u = 0; u < _width; ++u) {
+        if(columnMin[u] <= _depthRangeMm) {
+            _sectorColumns[_columnSector[u]].push_back(columnMin[u]);
+        }
+    }
+
+    outSectorsMsg.min_ranges.resize(_numSectors);
+    outSectorsMsg.percentile_ranges.resize(_numSectors);
+    for(int s = 0; s < _numSectors; ++s) {
+        auto& columns = _sectorColumns[s];
+        if(columns.empty()) {
+            outSectorsMsg.min_ranges[s] = std::numeric_limits<float>::infinity();
+            outSectorsMsg.percentile_ranges[s] = std::numeric_limits<float>::infinity();
+            continue;
+        }
+        auto nth = columns.begin() + static_cast<size_t>(_percentile * (columns.size() - 1));
+        std::nth_element(columns.begin(), nth, columns.end());
+        uint16_t nearest = *std::min_element(columns.begin(), nth + 1);
+        // converting mm to meters
+        outSectorsMsg.min_ranges[s] = (nearest + minDepthMm) / 1000.0f;
+        outSectorsMsg.percentile_ranges[s] = (*nth + minDepthMm) / 1000.0f;
+    }
+}
+
+DepthSectorsPtr DepthSectorConverter::toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData) {
+#ifdef IS_ROS2
+    DepthSectorsPtr ptr = std::make_shared<DepthaiMsgs::DepthSectors>();
+#else
+    DepthSectorsPtr ptr = boost::make_shared<DepthaiMsgs::DepthSectors>();
+#endif
+    toRosMsg(inData, *ptr);
+    return ptr;
+}
+
+}  // namespace ros
+}  // namespace dai
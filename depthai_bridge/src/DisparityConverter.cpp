@@ -25,15 +25,32 @@ std::unordered_map<dai::RawImgFrame::Type, std::string> DisparityConverter::plan
 */
 
 DisparityConverter::DisparityConverter(const std::string frameName, float focalLength, float baseline, float minDepth, float maxDepth)
-    : _frameName(frameName), _focalLength(focalLength), _baseline(baseline / 100.0), _minDepth(minDepth / 100.0), _maxDepth(maxDepth / 100.0) {}
+    : _config(Config{frameName, focalLength, baseline, minDepth, maxDepth}) {}
+
+DisparityConverter::Config DisparityConverter::getConfig() const {
+    return *_config.load();
+}
+
+void DisparityConverter::setConfig(Config config) {
+    validate(config);
+    _config.store(std::move(config));
+}
+
+void DisparityConverter::validate(const Config& config) {
+    if(config.focalLength <= 0 || config.baseline <= 0 || config.minDepth <= 0 || config.minDepth >= config.maxDepth) {
+        throw std::runtime_error("DisparityConverter needs a positive focal length and baseline and 0 < minDepth < maxDepth");
+    }
+}
 
 void DisparityConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DisparityMsgs::DisparityImage& outDispImageMsg) {
     auto tstamp = inData->getTimestamp();
+    const auto config = _config.load();
+    const float baseline = config->baseline / 100.0, minDepth = config->minDepth / 100.0, maxDepth = config->maxDepth / 100.0;
 
-    outDispImageMsg.header.frame_id = _frameName;
-    outDispImageMsg.f = _focalLength;
-    outDispImageMsg.min_disparity = _focalLength * _baseline / _maxDepth;
-    outDispImageMsg.max_disparity = _focalLength * _baseline / _minDepth;
+    outDispImageMsg.header.frame_id = config->frameName;
+    outDispImageMsg.f = config->focalLength;
+    outDispImageMsg.min_disparity = config->focalLength * baseline / maxDepth;
+    outDispImageMsg.max_disparity = config->focalLength * baseline / minDepth;
 
 #ifdef IS_ROS2
     auto rclNow = rclcpp::Clock().now();
@@ -41,7 +58,7 @@ void DisparityConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, Dispari
     auto diffTime = steadyTime - tstamp;
     auto rclStamp = rclNow - diffTime;
     outDispImageMsg.header.stamp = rclStamp;
-    outDispImageMsg.t = _baseline / 100;  // converting cm to meters
+    outDispImageMsg.t = baseline / 100;  // converting cm to meters
     sensor_msgs::msg::Image& outImageMsg = outDispImageMsg.image;
 #else
     auto rosNow = ::ros::Time::now();
@@ -52,7 +69,7 @@ void DisparityConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, Dispari
     outDispImageMsg.header.stamp = rosStamp;
 
     outDispImageMsg.header.seq = inData->getSequenceNum();
-    outDispImageMsg.T = _baseline / 100;  // converting cm to meters
+    outDispImageMsg.T = baseline / 100;  // converting cm to meters
     sensor_msgs::Image& outImageMsg = outDispImageMsg.image;
 #endif
 
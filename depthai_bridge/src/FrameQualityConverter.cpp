@@ -0,0 +1,81 @@
+#include <depthai_bridge/FrameQualityConverter.hpp>
+
+namespace dai {
+
+namespace ros {
+
+FrameQualityConverter::FrameQualityConverter(const std::string frameName, int downsample, uint8_t darkThreshold, uint8_t brightThreshold)
+    : _frameName(frameName), _downsample(std::max(1, downsample)), _darkThreshold(darkThreshold), _brightThreshold(brightThreshold) {}
+
+bool FrameQualityConverter::downsampleLuma(std::shared_ptr<dai::ImgFrame> inData) {
+    const int width = inData->getWidth(), height = inData->getHeight();
+    const cv::Size size(std::max(1, width / _downsample), std::max(1, height / _downsample));
+    uint8_t* data = inData->getData().data();
+    switch(inData->getType()) {
+        case dai::RawImgFrame::Type::NV12:
+        case dai::RawImgFrame::Type::YUV420p:
+        case dai::RawImgFrame::Type::GRAY8:
+        case dai::RawImgFrame::Type::RAW8:
+            cv::resize(cv::Mat(height, width, CV_8UC1, data), _luma, size, 0, 0, cv::INTER_AREA);
+            return true;
+        case dai::RawImgFrame::Type::RGB888p:
+        case dai::RawImgFrame::Type::BGR888p:
+            cv::resize(cv::Mat(height, width, CV_8UC1, data + width * height), _luma, size, 0, 0, cv::INTER_AREA);
+            return true;
+        case dai::RawImgFrame::Type::RGB888i:
+        case dai::RawImgFrame::Type::BGR888i:
+            // Shrinking first leaves the gray conversion a fraction of the pixels
+            cv::resize(cv::Mat(height, width, CV_8UC3, data), _color, size, 0, 0, cv::INTER_AREA);
+            cv::cvtColor(_color, _luma, inData->getType() == dai::RawImgFrame::Type::RGB888i ? cv::COLOR_RGB2GRAY : cv::COLOR_BGR2GRAY);
+            return true;
+        default:
+            return false;
+    }
+}
+
+void FrameQualityConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, DepthaiMsgs::FrameQuality& outQualityMsg) {
+    outQualityMsg.header.frame_id = _frameName;
+    outQualityMsg.header.stamp = getFrameTime(inData->getTimestamp());
+#ifndef IS_ROS2
+    outQualityMsg.header.seq = inData->getSequenceNum();
+#endif
+    outQualityMsg.sequence_num = inData->getSequenceNum();
+    outQualityMsg.sharpness = 0;
+    outQualityMsg.mean_luma = 0;
+    outQualityMsg.underexposed_ratio = 0;
+    outQualityMsg.overexposed_ratio = 0;
+    if(!downsampleLuma(inData)) return;
+
+    // 4-neighbour Laplacian, 16 bit so strong edges do not saturate
+    cv::Laplacian(_luma, _laplacian, CV_16S, 1);
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(_laplacian, mean, stddev);
+    outQualityMsg.sharpness = static_cast<float>(stddev[0] * stddev[0]);
+
+    uint64_t sum = 0, dark = 0, bright = 0;
+    for(int row = 0; row < _luma.rows; ++row) {
+        const uint8_t* pixel = _luma.ptr<uint8_t>(row);
+        for(int col = 0; col < _luma.cols; ++col) {
+            sum += pixel[col];
+            dark += pixel[col] <= _darkThreshold;
+            bright += pixel[col] >= _brightThreshold;
+        }
+    }
+    const double pixels = static_cast<double>(_luma.rows) * _luma.cols;
+    outQualityMsg.mean_luma = static_cast<float>(sum / pixels);
+    outQualityMsg.underexposed_ratio = static_cast<float>(dark / pixels);
+    outQualityMsg.overexposed_ratio = static_cast<float>(bright / pixels);
+}
+
+FrameQualityPtr FrameQualityConverter::toRosMsgPtr(std::shared_ptr<dai::ImgFrame> inData) {
+#ifdef IS_ROS2
+    FrameQualityPtr ptr = std::make_shared<DepthaiMsgs::FrameQuality>();
+#else
+    FrameQualityPtr ptr = boost::make_shared<DepthaiMsgs::FrameQuality>();
+#endif
+    toRosMsg(inData, *ptr);
+    return ptr;
+}
+
+}  // namespace ros
+}  // namespace dai
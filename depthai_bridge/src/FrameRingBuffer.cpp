@@ -0,0 +1,124 @@
+#include <depthai_bridge/FrameRingBuffer.hpp>
+#include <stdexcept>
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+FrameRingBuffer::FrameRingBuffer(std::shared_ptr<rclcpp::Node> node,
+                                 std::string serviceName,
+                                 std::string burstTopic,
+                                 ConvertFunc converter,
+                                 std::chrono::milliseconds history,
+                                 size_t maxBytes)
+    : _converter(converter), _history(history), _maxBytes(maxBytes), _node(node), _running(true) {
+    _burstPublisher = _node->create_publisher<ImageMsgs::Image>(burstTopic, rclcpp::QoS(100).reliable());
+    _triggerService = _node->create_service<DepthaiSrvs::TriggerNamed>(
+        serviceName, std::bind(&FrameRingBuffer::triggerCallback, this, std::placeholders::_1, std::placeholders::_2));
+    _publishingThread = std::thread(&FrameRingBuffer::publishingLoop, this);
+}
+
+void FrameRingBuffer::triggerCallback(const std::shared_ptr<DepthaiSrvs::TriggerNamed::Request> request,
+                                      std::shared_ptr<DepthaiSrvs::TriggerNamed::Response> response) {
+    try {
+        size_t numFrames = trigger();
+        response->success = numFrames > 0;
+        response->message = "Publishing " + std::to_string(numFrames) + " buffered frames for '" + request->name + "'";
+    } catch(const std::runtime_error& e) {
+        response->success = false;
+        response->message = std::string(e.what()) + ", ignoring '" + request->name + "'";
+    }
+}
+#else
+FrameRingBuffer::FrameRingBuffer(
+    ::ros::NodeHandle nh, std::string serviceName, std::string burstTopic, ConvertFunc converter, std::chrono::milliseconds history, size_t maxBytes)
+    : _converter(converter), _history(history), _maxBytes(maxBytes), _nh(nh), _running(true) {
+    _burstPublisher = _nh.advertise<ImageMsgs::Image>(burstTopic, 100);
+    _triggerService = _nh.advertiseService(serviceName, &FrameRingBuffer::triggerCallback, this);
+    _publishingThread = std::thread(&FrameRingBuffer::publishingLoop, this);
+}
+
+bool FrameRingBuffer::triggerCallback(DepthaiSrvs::TriggerNamed::Request& request, DepthaiSrvs::TriggerNamed::Response& response) {
+    try {
+        size_t numFrames = trigger();
+        response.success = numFrames > 0;
+        response.message = "Publishing " + std::to_string(numFrames) + " buffered frames for '" + request.name + "'";
+    } catch(const std::runtime_error& e) {
+        response.success = false;
+        response.message = std::string(e.what()) + ", ignoring '" + request.name + "'";
+    }
+    return true;
+}
+#endif
+
+FrameRingBuffer::~FrameRingBuffer() {
+    {
+        // Under the mutex, so the loop can not miss the notification between checking _running and waiting
+        std::lock_guard<std::mutex> lock(_framesMutex);
+        _running = false;
+    }
+    _burstCv.notify_one();
+    if(_publishingThread.joinable()) _publishingThread.join();
+}
+
+void FrameRingBuffer::addFrame(std::shared_ptr<dai::ImgFrame> inData) {
+    std::lock_guard<std::mutex> lock(_framesMutex);
+    _frames.push_back(inData);
+    ++_addedFrames;
+    _bufferedBytes += inData->getData().size();
+
+    const auto oldestKept = inData->getTimestamp() - _history;
+    while(_frames.size() > 1 && (_bufferedBytes + _burstOnlyBytes > _maxBytes || _frames.front()->getTimestamp() < oldestKept)) {
+        const size_t bytes = _frames.front()->getData().size();
+        // A frame the burst still has to publish stays in memory, it only changes hands
+        const uint64_t released = _addedFrames - _frames.size();
+        if(released >= _burstFirst && released < _burstFirst + _burst.size()) _burstOnlyBytes += bytes;
+        _bufferedBytes -= bytes;
+        _frames.pop_front();
+    }
+}
+
+size_t FrameRingBuffer::trigger() {
+    size_t numFrames;
+    {
+        std::lock_guard<std::mutex> lock(_framesMutex);
+        if(!_burst.empty()) throw std::runtime_error("The previous burst is still being published");
+        // The frames stay shared with the buffer, the burst costs no memory until the buffer releases them
+        _burst.assign(_frames.begin(), _frames.end());
+        _burstFirst = _addedFrames - _frames.size();
+        numFrames = _burst.size();
+    }
+    if(numFrames > 0) _burstCv.notify_one();
+    return numFrames;
+}
+
+void FrameRingBuffer::publishingLoop() {
+    while(_running) {
+        std::shared_ptr<dai::ImgFrame> frame;
+        {
+            std::unique_lock<std::mutex> lock(_framesMutex);
+            _burstCv.wait(lock, [this]() { return !_running || !_burst.empty(); });
+            if(!_running) break;
+            frame = _burst.front();
+        }
+
+        // Conversion happens here, off the thread feeding the buffer, so live publishing is not held up
+        ImageMsgs::Image opMsg;
+        _converter(frame, opMsg);
+#ifdef IS_ROS2
+        _burstPublisher->publish(opMsg);
+#else
+        _burstPublisher.publish(opMsg);
+#endif
+
+        // Released from the budget only now, the frame was held while converting
+        std::lock_guard<std::mutex> lock(_framesMutex);
+        if(_burstFirst < _addedFrames - _frames.size()) _burstOnlyBytes -= frame->getData().size();
+        _burst.pop_front();
+        ++_burstFirst;
+    }
+}
+
+}  // namespace ros
+}  // namespace dai
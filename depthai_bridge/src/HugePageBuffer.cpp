@@ -0,0 +1,34 @@
+#include <depthai_bridge/HugePageBuffer.hpp>
+
+#ifdef __linux__
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+constexpr size_t kHugePageSize = 2 * 1024 * 1024;
+
+}  // namespace
+
+void reserveHugePages(std::vector<uint8_t>& buffer, size_t size) {
+    // One extra huge page, the allocation is not 2 MB aligned and only aligned 2 MB ranges can be backed by a huge page
+    const size_t capacity = (size + 2 * kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+    std::vector<uint8_t> fresh;
+    fresh.reserve(capacity);
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    // The reserved pages are not touched yet, so the advice applies from the first fault
+    const uintptr_t pageSize = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(fresh.data()) + pageSize - 1) & ~(pageSize - 1);
+    const uintptr_t end = reinterpret_cast<uintptr_t>(fresh.data()) + fresh.capacity();
+    if(end > begin) madvise(reinterpret_cast<void*>(begin), end - begin, MADV_HUGEPAGE);
+#endif
+    buffer.swap(fresh);
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -9,6 +9,20 @@ namespace dai {
 
 namespace ros {
 
+namespace {
+
+// Scratch state of the conversion is kept per converting thread instead of per converter, so toRosMsg() stays
+// reentrant: a converter can serve the live BridgePublisher and e.g. a FrameRingBuffer at the same time
+struct ClaheCache {
+    cv::Ptr<cv::CLAHE> clahe;
+    double clipLimit = 0;
+    int tiles = 0;
+};
+thread_local ClaheCache claheCache;
+thread_local std::vector<uint8_t> scaledYuv;
+
+}  // namespace
+
 std::unordered_map<dai::RawImgFrame::Type, std::string> ImageConverter::encodingEnumMap = {{dai::RawImgFrame::Type::YUV422i, "yuv422"},
                                                                                            {dai::RawImgFrame::Type::RGBA8888, "rgba8"},
                                                                                            {dai::RawImgFrame::Type::RGB888i, "rgb8"},
@@ -25,15 +39,16 @@ std::unordered_map<dai::RawImgFrame::Type, std::string> ImageConverter::planarEn
     {dai::RawImgFrame::Type::NV12, "rgb8"},
     {dai::RawImgFrame::Type::YUV420p, "rgb8"}};
 
-ImageConverter::ImageConverter(bool interleaved) : _daiInterleaved(interleaved) {}
+ImageConverter::ImageConverter(bool interleaved) : _daiInterleaved(interleaved), _config(Config{}) {}
 
-ImageConverter::ImageConverter(const std::string frameName, bool interleaved) : _frameName(frameName), _daiInterleaved(interleaved) {}
+ImageConverter::ImageConverter(const std::string frameName, bool interleaved) : _daiInterleaved(interleaved), _config(Config{frameName}) {}
 
 void ImageConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::Image& outImageMsg) {
     auto tstamp = inData->getTimestamp();
+    const auto config = _config.load();
 
     StdMsgs::Header header;
-    header.frame_id = _frameName;
+    header.frame_id = config->frameName;
 
 #ifdef IS_ROS2
     auto rclNow = rclcpp::Clock().now();
@@ -51,9 +66,26 @@ void ImageConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::
     header.seq = inData->getSequenceNum();
 #endif
 
-    if(planarEncodingEnumMap.find(inData->getType()) != planarEncodingEnumMap.end()) {
+    const auto type = inData->getType();
+    const bool yuv = type == dai::RawImgFrame::Type::NV12 || type == dai::RawImgFrame::Type::YUV420p;
+    const unsigned downscale = config->downscale;
+    const bool yuvScalable = inData->getWidth() % (2 * downscale) == 0 && inData->getHeight() % (2 * downscale) == 0;
+    if(yuv && (config->monoOutput || (downscale > 1 && yuvScalable))) {
+        outImageMsg.header = header;
+        reducedYuvToRosMsg(inData, *config, yuvScalable ? downscale : 1, outImageMsg);
+    } else if(planarEncodingEnumMap.find(inData->getType()) != planarEncodingEnumMap.end()) {
+        // The color conversion writes straight into the message buffer, saving the copy through cv_bridge
+        outImageMsg.header = header;
+        outImageMsg.encoding = sensor_msgs::image_encodings::BGR8;
+        outImageMsg.height = inData->getHeight();
+        outImageMsg.width = inData->getWidth();
+        outImageMsg.step = inData->getWidth() * 3;
+        outImageMsg.is_bigendian = false;
+        outImageMsg.data.resize(outImageMsg.step * outImageMsg.height);
+
         // cv::Mat inImg = inData->getCvFrame();
-        cv::Mat mat, output;
+        cv::Mat mat;
+        cv::Mat output(inData->getHeight(), inData->getWidth(), CV_8UC3, outImageMsg.data.data());
         cv::Size size = {0, 0};
         int type = 0;
         switch(inData->getType()) {
@@ -104,10 +136,9 @@ void ImageConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::
                 break;
 
             default:
-                output = mat.clone();
+                mat.copyTo(output);
                 break;
         }
-        cv_bridge::CvImage(header, sensor_msgs::image_encodings::BGR8, output).toImageMsg(outImageMsg);
 
     } else if(encodingEnumMap.find(inData->getType()) != encodingEnumMap.end()) {
         // copying the data to ros msg
@@ -122,8 +153,30 @@ void ImageConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::
         else
             outImageMsg.is_bigendian = true;
 
+        const bool mono8 = type == dai::RawImgFrame::Type::GRAY8 || type == dai::RawImgFrame::Type::RAW8;
+        const bool scalable = mono8 || type == dai::RawImgFrame::Type::RAW16;
+        if(downscale > 1 && scalable) {
+            const int cvType = type == dai::RawImgFrame::Type::RAW16 ? CV_16UC1 : CV_8UC1;
+            cv::Mat input(inData->getHeight(), inData->getWidth(), cvType, inData->getData().data());
+            outImageMsg.height = inData->getHeight() / downscale;
+            outImageMsg.width = inData->getWidth() / downscale;
+            outImageMsg.step = outImageMsg.width * input.elemSize();
+            outImageMsg.data.resize(outImageMsg.step * outImageMsg.height);
+            cv::Mat output(outImageMsg.height, outImageMsg.width, cvType, outImageMsg.data.data());
+            // Averaging depth across an object's edge would invent depths in between, pick samples instead
+            cv::resize(input, output, output.size(), 0, 0, type == dai::RawImgFrame::Type::RAW16 ? cv::INTER_NEAREST : cv::INTER_AREA);
+            if(mono8) enhanceMono(*config, output, output);
+            return;
+        }
+
         size_t size = inData->getData().size();
         outImageMsg.data.resize(size);
+        if(mono8 && config->enhancement != Enhancement::NONE) {
+            cv::Mat input(inData->getHeight(), inData->getWidth(), CV_8UC1, inData->getData().data(), outImageMsg.step);
+            cv::Mat output(outImageMsg.height, outImageMsg.width, CV_8UC1, outImageMsg.data.data(), outImageMsg.step);
+            enhanceMono(*config, input, output);
+            return;
+        }
         unsigned char* imageMsgDataPtr = reinterpret_cast<unsigned char*>(&outImageMsg.data[0]);
         unsigned char* daiImgData = reinterpret_cast<unsigned char*>(inData->getData().data());
 
@@ -134,6 +187,126 @@ void ImageConverter::toRosMsg(std::shared_ptr<dai::ImgFrame> inData, ImageMsgs::
     return;
 }
 
+ImageConverter::Config ImageConverter::getConfig() const {
+    return *_config.load();
+}
+
+void ImageConverter::setConfig(Config config) {
+    validate(config);
+    _config.store(std::move(config));
+}
+
+void ImageConverter::validate(const Config& config) {
+    if(config.downscale == 0) {
+        throw std::runtime_error("ImageConverter downscale factor has to be at least 1");
+    }
+    if(config.claheClipLimit <= 0 || config.claheTiles < 1) {
+        throw std::runtime_error("ImageConverter CLAHE needs a positive clip limit and at least one tile");
+    }
+}
+
+void ImageConverter::setFrameName(std::string frameName) {
+    _config.update([&frameName](Config& config) { config.frameName = frameName; });
+}
+
+void ImageConverter::setMonoOutput(bool mono) {
+    _config.update([mono](Config& config) { config.monoOutput = mono; });
+}
+
+void ImageConverter::setDownscale(unsigned factor) {
+    if(factor == 0) {
+        throw std::runtime_error("ImageConverter downscale factor has to be at least 1");
+    }
+    _config.update([factor](Config& config) { config.downscale = factor; });
+}
+
+void ImageConverter::setEnhancement(Enhancement enhancement, double claheClipLimit, int claheTiles) {
+    Config checked;
+    checked.claheClipLimit = claheClipLimit;
+    checked.claheTiles = claheTiles;
+    validate(checked);
+    _config.update([=](Config& config) {
+        config.enhancement = enhancement;
+        config.claheClipLimit = claheClipLimit;
+        config.claheTiles = claheTiles;
+    });
+}
+
+const LatencyHistogram& ImageConverter::getEnhancementTime() const {
+    return *_enhancementTime;
+}
+
+bool ImageConverter::enhanceMono(const Config& config, const cv::Mat& input, cv::Mat& output) {
+    if(config.enhancement == Enhancement::NONE) return false;
+
+    const auto start = std::chrono::steady_clock::now();
+    if(config.enhancement == Enhancement::EQUALIZE) {
+        cv::equalizeHist(input, output);
+    } else {
+        // Recreated only when retuned, it keeps its buffers between frames
+        if(!claheCache.clahe || claheCache.clipLimit != config.claheClipLimit || claheCache.tiles != config.claheTiles) {
+            claheCache.clahe = cv::createCLAHE(config.claheClipLimit, cv::Size(config.claheTiles, config.claheTiles));
+            claheCache.clipLimit = config.claheClipLimit;
+            claheCache.tiles = config.claheTiles;
+        }
+        claheCache.clahe->apply(input, output);
+    }
+    _enhancementTime->record(std::chrono::steady_clock::now() - start);
+    return true;
+}
+
+void ImageConverter::reducedYuvToRosMsg(std::shared_ptr<dai::ImgFrame> inData, const Config& config, unsigned scale, ImageMsgs::Image& outImageMsg) {
+    const int width = inData->getWidth(), height = inData->getHeight();
+    const int outWidth = width / scale, outHeight = height / scale;
+    uint8_t* src = inData->getData().data();
+    cv::Mat luma(height, width, CV_8UC1, src);
+
+    outImageMsg.height = outHeight;
+    outImageMsg.width = outWidth;
+    outImageMsg.is_bigendian = false;
+
+    if(config.monoOutput) {
+        outImageMsg.encoding = sensor_msgs::image_encodings::MONO8;
+        outImageMsg.step = outWidth;
+        outImageMsg.data.resize(outImageMsg.step * outHeight);
+        cv::Mat output(outHeight, outWidth, CV_8UC1, outImageMsg.data.data());
+        if(scale == 1) {
+            if(!enhanceMono(config, luma, output)) luma.copyTo(output);
+        } else {
+            cv::resize(luma, output, output.size(), 0, 0, cv::INTER_AREA);
+            enhanceMono(config, output, output);
+        }
+        return;
+    }
+
+    // Shrink the planes first, the color conversion then only touches the output pixels
+    scaledYuv.resize(outWidth * outHeight * 3 / 2);
+    cv::Mat scaledLuma(outHeight, outWidth, CV_8UC1, scaledYuv.data());
+    cv::resize(luma, scaledLuma, scaledLuma.size(), 0, 0, cv::INTER_AREA);
+    uint8_t* chroma = src + width * height;
+    uint8_t* scaledChroma = scaledYuv.data() + outWidth * outHeight;
+    if(inData->getType() == dai::RawImgFrame::Type::NV12) {
+        cv::Mat uv(height / 2, width / 2, CV_8UC2, chroma);
+        cv::Mat scaledUv(outHeight / 2, outWidth / 2, CV_8UC2, scaledChroma);
+        cv::resize(uv, scaledUv, scaledUv.size(), 0, 0, cv::INTER_AREA);
+    } else {
+        for(int plane = 0; plane < 2; ++plane) {
+            cv::Mat u(height / 2, width / 2, CV_8UC1, chroma + plane * (width / 2) * (height / 2));
+            cv::Mat scaledU(outHeight / 2, outWidth / 2, CV_8UC1, scaledChroma + plane * (outWidth / 2) * (outHeight / 2));
+            cv::resize(u, scaledU, scaledU.size(), 0, 0, cv::INTER_AREA);
+        }
+    }
+
+    outImageMsg.encoding = sensor_msgs::image_encodings::BGR8;
+    outImageMsg.step = outWidth * 3;
+    outImageMsg.data.resize(outImageMsg.step * outHeight);
+    cv::Mat yuvImage(outHeight * 3 / 2, outWidth, CV_8UC1, scaledYuv.data());
+    cv::Mat output(outHeight, outWidth, CV_8UC3, outImageMsg.data.data());
+    cv::cvtColor(yuvImage,
+                 output,
+                 inData->getType() == dai::RawImgFrame::Type::NV12 ? cv::ColorConversionCodes::COLOR_YUV2BGR_NV12 : cv::ColorConversionCodes::COLOR_YUV2BGR_IYUV);
+}
+
 // TODO(sachin): Not tested
 void ImageConverter::toDaiMsg(const ImageMsgs::Image& inMsg, dai::ImgFrame& outData) {
     std::unordered_map<dai::RawImgFrame::Type, std::string>::iterator revEncodingIter;
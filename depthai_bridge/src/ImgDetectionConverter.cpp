@@ -5,27 +5,43 @@ namespace dai {
 namespace ros {
 
 ImgDetectionConverter::ImgDetectionConverter(std::string frameName, int width, int height, bool normalized)
-    : _frameName(frameName), _width(width), _height(height), _normalized(normalized), _sequenceNum(0) {}
+    : _sequenceNum(0), _config(Config{frameName, width, height, normalized}) {}
+
+ImgDetectionConverter::Config ImgDetectionConverter::getConfig() const {
+    return *_config.load();
+}
+
+void ImgDetectionConverter::setConfig(Config config) {
+    validate(config);
+    _config.store(std::move(config));
+}
+
+void ImgDetectionConverter::validate(const Config& config) {
+    if(!config.normalized && (config.width <= 0 || config.height <= 0)) {
+        throw std::runtime_error("ImgDetectionConverter needs a positive width and height unless publishing normalized detections");
+    }
+}
 
 void ImgDetectionConverter::toRosMsg(std::shared_ptr<dai::ImgDetections> inNetData,
                                      VisionMsgs::Detection2DArray& opDetectionMsg,
                                      TimePoint tStamp,
                                      int32_t sequenceNum) {
-    toRosMsg(inNetData, opDetectionMsg);
+    const auto config = _config.load();
     int32_t sec = std::chrono::duration_cast<std::chrono::seconds>(tStamp.time_since_epoch()).count();
     int32_t nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(tStamp.time_since_epoch()).count() % 1000000000UL;
 #ifndef IS_ROS2
+    _sequenceNum++;
     if(sequenceNum != -1) _sequenceNum = sequenceNum;
     opDetectionMsg.header.seq = _sequenceNum;
     opDetectionMsg.header.stamp = ::ros::Time(sec, nsec);
 #else
     opDetectionMsg.header.stamp = rclcpp::Time(sec, nsec);
 #endif
-
-    opDetectionMsg.header.frame_id = _frameName;
+    detectionsToRosMsg(inNetData, *config, opDetectionMsg);
 }
 
 void ImgDetectionConverter::toRosMsg(std::shared_ptr<dai::ImgDetections> inNetData, VisionMsgs::Detection2DArray& opDetectionMsg) {
+    const auto config = _config.load();
 // setting the header
 #ifndef IS_ROS2
     opDetectionMsg.header.seq = _sequenceNum;
@@ -34,24 +50,29 @@ void ImgDetectionConverter::toRosMsg(std::shared_ptr<dai::ImgDetections> inNetDa
 #else
     opDetectionMsg.header.stamp = rclcpp::Clock().now();
 #endif
+    detectionsToRosMsg(inNetData, *config, opDetectionMsg);
+}
 
-    opDetectionMsg.header.frame_id = _frameName;
+void ImgDetectionConverter::detectionsToRosMsg(std::shared_ptr<dai::ImgDetections> inNetData,
+                                               const Config& config,
+                                               VisionMsgs::Detection2DArray& opDetectionMsg) {
+    opDetectionMsg.header.frame_id = config.frameName;
     opDetectionMsg.detections.resize(inNetData->detections.size());
 
     // TODO(Sachin): check if this works fine for normalized detection
     // publishing
     for(int i = 0; i < inNetData->detections.size(); ++i) {
         int xMin, yMin, xMax, yMax;
-        if(_normalized) {
+        if(config.normalized) {
             xMin = inNetData->detections[i].xmin;
             yMin = inNetData->detections[i].ymin;
             xMax = inNetData->detections[i].xmax;
             yMax = inNetData->detections[i].ymax;
         } else {
-            xMin = inNetData->detections[i].xmin * _width;
-            yMin = inNetData->detections[i].ymin * _height;
-            xMax = inNetData->detections[i].xmax * _width;
-            yMax = inNetData->detections[i].ymax * _height;
+            xMin = inNetData->detections[i].xmin * config.width;
+            yMin = inNetData->detections[i].ymin * config.height;
+            xMax = inNetData->detections[i].xmax * config.width;
+            yMax = inNetData->detections[i].ymax * config.height;
         }
 
         float xSize = xMax - xMin;
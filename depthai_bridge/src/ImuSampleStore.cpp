@@ -0,0 +1,243 @@
+#include <cmath>
+#include <depthai_bridge/ImuSampleStore.hpp>
+#include <limits>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+// Queries racing with the writer are retried this many times before giving up
+constexpr int kMaxAttempts = 4;
+
+int64_t toNanoseconds(ImuSampleStore::TimePoint t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+template <size_t Channels>
+std::array<float, Channels> lerp(const std::array<float, Channels>& a, const std::array<float, Channels>& b, float weight) {
+    std::array<float, Channels> result;
+    for(size_t c = 0; c < Channels; ++c) {
+        result[c] = a[c] + weight * (b[c] - a[c]);
+    }
+    return result;
+}
+
+}  // namespace
+
+template <size_t Channels>
+ImuSampleStore::Ring<Channels>::Ring(size_t capacity)
+    : _capacity([capacity]() {
+          uint64_t rounded = 4;
+          while(rounded < capacity) rounded <<= 1;
+          return rounded;
+      }()),
+      _mask(_capacity - 1),
+      _timestamps(new std::atomic<int64_t>[_capacity]),
+      _head(0),
+      _lastTimestamp(std::numeric_limits<int64_t>::min()) {
+    for(auto& channel : _channels) {
+        channel.reset(new std::atomic<float>[_capacity]);
+    }
+}
+
+template <size_t Channels>
+void ImuSampleStore::Ring<Channels>::push(int64_t timestamp, const Sample& sample) {
+    if(timestamp <= _lastTimestamp) return;
+    _lastTimestamp = timestamp;
+
+    const uint64_t index = _head.load(std::memory_order_relaxed);
+    const uint64_t slot = index & _mask;
+    // Pairs with the fence in stillValid: a reader that sees any of the stores below also sees head == index,
+    // which invalidates the slot being overwritten
+    std::atomic_thread_fence(std::memory_order_release);
+    _timestamps[slot].store(timestamp, std::memory_order_relaxed);
+    for(size_t c = 0; c < Channels; ++c) {
+        _channels[c][slot].store(sample[c], std::memory_order_relaxed);
+    }
+    _head.store(index + 1, std::memory_order_release);
+}
+
+template <size_t Channels>
+typename ImuSampleStore::Ring<Channels>::Sample ImuSampleStore::Ring<Channels>::load(uint64_t index) const {
+    Sample sample;
+    const uint64_t slot = index & _mask;
+    for(size_t c = 0; c < Channels; ++c) {
+        sample[c] = _channels[c][slot].load(std::memory_order_relaxed);
+    }
+    return sample;
+}
+
+template <size_t Channels>
+uint64_t ImuSampleStore::Ring<Channels>::lowerBound(uint64_t lo, uint64_t hi, int64_t t) const {
+    while(lo < hi) {
+        const uint64_t mid = lo + (hi - lo) / 2;
+        if(_timestamps[mid & _mask].load(std::memory_order_relaxed) < t) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+template <size_t Channels>
+bool ImuSampleStore::Ring<Channels>::stillValid(uint64_t lo) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    // The writer may be overwriting the slot of index head - capacity
+    return lo + _capacity > _head.load(std::memory_order_relaxed);
+}
+
+template <size_t Channels>
+bool ImuSampleStore::Ring<Channels>::lookup(int64_t t, Sample& before, Sample& after, float& weight) const {
+    for(int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        const uint64_t lo = head >= _capacity ? head - _capacity + 1 : 0;
+        if(head == lo) return false;
+
+        bool found = false;
+        const uint64_t i = lowerBound(lo, head, t);
+        if(i < head) {
+            const int64_t ti = _timestamps[i & _mask].load(std::memory_order_relaxed);
+            if(ti == t) {
+                before = after = load(i);
+                weight = 0;
+                found = true;
+            } else if(i > lo) {
+                const int64_t tb = _timestamps[(i - 1) & _mask].load(std::memory_order_relaxed);
+                before = load(i - 1);
+                after = load(i);
+                weight = ti > tb ? static_cast<float>(t - tb) / static_cast<float>(ti - tb) : 0.0f;
+                found = true;
+            }
+        }
+        if(stillValid(lo)) return found;
+    }
+    return false;
+}
+
+template <size_t Channels>
+template <size_t K, class Integrand>
+bool ImuSampleStore::Ring<Channels>::integrate(int64_t begin, int64_t end, Integrand integrand, std::array<float, K>& integral) const {
+    integral.fill(0);
+    if(end <= begin) return true;
+
+    auto timestamp = [this](uint64_t index) { return _timestamps[index & _mask].load(std::memory_order_relaxed); };
+    auto accumulate = [&integral](const std::array<float, K>& a, const std::array<float, K>& b, int64_t dt) {
+        const float halfDt = 0.5e-9f * static_cast<float>(dt);
+        for(size_t k = 0; k < K; ++k) {
+            integral[k] += halfDt * (a[k] + b[k]);
+        }
+    };
+
+    for(int attempt = 0; attempt < kMaxAttempts; ++attempt) {
+        integral.fill(0);
+        const uint64_t head = _head.load(std::memory_order_acquire);
+        const uint64_t lo = head >= _capacity ? head - _capacity + 1 : 0;
+        if(head - lo < 2) return false;
+
+        bool covered = false;
+        uint64_t i = lowerBound(lo, head, begin);
+        if(i < head && (i > lo || timestamp(i) == begin)) {
+            // Integrand at the interpolated start of the range
+            const uint64_t first = timestamp(i) == begin ? i : i - 1;
+            Sample a = load(first), b = load(i);
+            int64_t ta = timestamp(first), tb = timestamp(i);
+            std::array<float, K> previous = integrand(tb > ta ? lerp(a, b, static_cast<float>(begin - ta) / static_cast<float>(tb - ta)) : a);
+            int64_t t = begin;
+
+            for(; i < head && timestamp(i) < end; ++i) {
+                const int64_t ti = timestamp(i);
+                std::array<float, K> current = integrand(load(i));
+                if(ti > t) accumulate(previous, current, ti - t);
+                previous = current;
+                t = ti;
+            }
+
+            if(i < head) {
+                ta = timestamp(i - 1);
+                tb = timestamp(i);
+                a = load(i - 1);
+                b = load(i);
+                accumulate(previous, integrand(lerp(a, b, static_cast<float>(end - ta) / static_cast<float>(tb - ta))), end - t);
+                covered = true;
+            }
+        }
+        if(stillValid(lo)) return covered;
+    }
+    return false;
+}
+
+ImuSampleStore::ImuSampleStore(size_t capacity) : _accelerometer(capacity), _gyroscope(capacity), _rotationVector(capacity) {}
+
+void ImuSampleStore::addImuData(std::shared_ptr<dai::IMUData> inData) {
+    for(const auto& packet : inData->packets) {
+        const auto& accel = packet.acceleroMeter;
+        const auto& gyro = packet.gyroscope;
+        const auto& rotation = packet.rotationVector;
+        _accelerometer.push(toNanoseconds(accel.timestamp.get()), {accel.x, accel.y, accel.z});
+        _gyroscope.push(toNanoseconds(gyro.timestamp.get()), {gyro.x, gyro.y, gyro.z});
+        _rotationVector.push(toNanoseconds(rotation.timestamp.get()), {rotation.i, rotation.j, rotation.k, rotation.real});
+    }
+}
+
+bool ImuSampleStore::getAcceleration(TimePoint t, Vector3& acceleration) const {
+    Ring<3>::Sample before, after;
+    float weight;
+    if(!_accelerometer.lookup(toNanoseconds(t), before, after, weight)) return false;
+    const auto value = lerp(before, after, weight);
+    acceleration = {value[0], value[1], value[2]};
+    return true;
+}
+
+bool ImuSampleStore::getAngularVelocity(TimePoint t, Vector3& angularVelocity) const {
+    Ring<3>::Sample before, after;
+    float weight;
+    if(!_gyroscope.lookup(toNanoseconds(t), before, after, weight)) return false;
+    const auto value = lerp(before, after, weight);
+    angularVelocity = {value[0], value[1], value[2]};
+    return true;
+}
+
+bool ImuSampleStore::getOrientation(TimePoint t, Quaternion& orientation) const {
+    Ring<4>::Sample before, after;
+    float weight;
+    if(!_rotationVector.lookup(toNanoseconds(t), before, after, weight)) return false;
+
+    // q and -q are the same rotation, interpolate along the shorter arc
+    const float dot = before[0] * after[0] + before[1] * after[1] + before[2] * after[2] + before[3] * after[3];
+    if(dot < 0) {
+        for(auto& c : after) c = -c;
+    }
+    const auto value = lerp(before, after, weight);
+    const float norm = std::sqrt(value[0] * value[0] + value[1] * value[1] + value[2] * value[2] + value[3] * value[3]);
+    if(norm <= 0) return false;
+    orientation = {value[0] / norm, value[1] / norm, value[2] / norm, value[3] / norm};
+    return true;
+}
+
+bool ImuSampleStore::integrateAngularVelocity(TimePoint begin, TimePoint end, Vector3& rotation) const {
+    std::array<float, 3> integral;
+    if(!_gyroscope.integrate(toNanoseconds(begin), toNanoseconds(end), [](const Ring<3>::Sample& s) { return s; }, integral)) return false;
+    rotation = {integral[0], integral[1], integral[2]};
+    return true;
+}
+
+bool ImuSampleStore::integrateAngularSpeed(TimePoint begin, TimePoint end, float& angle) const {
+    std::array<float, 1> integral;
+    auto speed = [](const Ring<3>::Sample& s) { return std::array<float, 1>{{std::sqrt(s[0] * s[0] + s[1] * s[1] + s[2] * s[2])}}; };
+    if(!_gyroscope.integrate(toNanoseconds(begin), toNanoseconds(end), speed, integral)) return false;
+    angle = integral[0];
+    return true;
+}
+
+bool ImuSampleStore::integrateAcceleration(TimePoint begin, TimePoint end, Vector3& velocityChange) const {
+    std::array<float, 3> integral;
+    if(!_accelerometer.integrate(toNanoseconds(begin), toNanoseconds(end), [](const Ring<3>::Sample& s) { return s; }, integral)) return false;
+    velocityChange = {integral[0], integral[1], integral[2]};
+    return true;
+}
+
+}  // namespace ros
+}  // namespace dai
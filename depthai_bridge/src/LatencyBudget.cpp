@@ -0,0 +1,68 @@
+#include <algorithm>
+#include <depthai_bridge/LatencyBudget.hpp>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+constexpr int kCalmWindowsToRecover = 3;
+
+}  // namespace
+
+LatencyBudget::LatencyBudget(std::chrono::milliseconds budget, std::chrono::milliseconds window) : _budget(budget), _window(window), _level(Level::FULL) {}
+
+void LatencyBudget::setLevelCallback(LevelCallback callback) {
+    _levelCallback = callback;
+}
+
+void LatencyBudget::record(std::chrono::steady_clock::time_point now, std::chrono::nanoseconds latency) {
+    _samples++;
+    if(latency > _budget) _overBudget++;
+    _maxLatency = std::max(_maxLatency, latency);
+    update(now);
+}
+
+void LatencyBudget::update(std::chrono::steady_clock::time_point now) {
+    if(!_started) {
+        _started = true;
+        _windowStart = now;
+    }
+    if(now - _windowStart < _window) return;
+
+    const Level level = _level.load(std::memory_order_relaxed);
+    if(_overBudget * 10 > _samples) {
+        _calmWindows = 0;
+        if(level != Level::DOWNSCALE) setLevel(static_cast<Level>(static_cast<int>(level) + 1));
+    } else if(_maxLatency * 10 < _budget * 7) {
+        if(++_calmWindows >= kCalmWindowsToRecover && level != Level::FULL) {
+            _calmWindows = 0;
+            setLevel(static_cast<Level>(static_cast<int>(level) - 1));
+        }
+    } else {
+        _calmWindows = 0;
+    }
+
+    _windowStart = now;
+    _samples = _overBudget = 0;
+    _maxLatency = std::chrono::nanoseconds(0);
+}
+
+bool LatencyBudget::skipFrame() {
+    if(_level.load(std::memory_order_relaxed) == Level::FULL) return false;
+    _skipped = !_skipped;
+    return _skipped;
+}
+
+LatencyBudget::Level LatencyBudget::getLevel() const {
+    return _level.load(std::memory_order_relaxed);
+}
+
+void LatencyBudget::setLevel(Level level) {
+    _level.store(level, std::memory_order_relaxed);
+    if(_levelCallback) _levelCallback(level);
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,68 @@
+#include <depthai_bridge/LatencyHistogram.hpp>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+// Everything below 2^kMinExponent ns (~1 us) shares the first bucket
+constexpr int kMinExponent = 10;
+constexpr int kSubBucketBits = 2;
+
+int highestBit(uint64_t value) {
+    return 63 - __builtin_clzll(value);
+}
+
+}  // namespace
+
+LatencyHistogram::LatencyHistogram() {
+    for(auto& count : _counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t nanoseconds) {
+    if(nanoseconds < (1ull << kMinExponent)) return 0;
+    const int exponent = highestBit(nanoseconds);
+    const uint64_t subBucket = (nanoseconds >> (exponent - kSubBucketBits)) & ((1u << kSubBucketBits) - 1);
+    const size_t index = 1 + (static_cast<size_t>(exponent - kMinExponent) << kSubBucketBits) + subBucket;
+    return index < kBuckets ? index : kBuckets - 1;
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if(index == 0) return 1ull << kMinExponent;
+    const size_t exponent = kMinExponent + ((index - 1) >> kSubBucketBits);
+    const uint64_t subBucket = (index - 1) & ((1u << kSubBucketBits) - 1);
+    return ((1ull << kSubBucketBits) + subBucket + 1) << (exponent - kSubBucketBits);
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds value) {
+    const uint64_t nanoseconds = value.count() > 0 ? static_cast<uint64_t>(value.count()) : 0;
+    _counts[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+}
+
+LatencyHistogram::Counts LatencyHistogram::getCounts() const {
+    Counts counts;
+    for(size_t i = 0; i < kBuckets; ++i) {
+        counts[i] = _counts[i].load(std::memory_order_relaxed);
+    }
+    return counts;
+}
+
+std::chrono::nanoseconds LatencyHistogram::percentile(const Counts& counts, double fraction) {
+    uint64_t total = 0;
+    for(auto count : counts) total += count;
+    if(total == 0) return std::chrono::nanoseconds(0);
+
+    const double rank = fraction * static_cast<double>(total);
+    uint64_t cumulative = 0;
+    for(size_t i = 0; i < kBuckets; ++i) {
+        cumulative += counts[i];
+        if(cumulative > 0 && static_cast<double>(cumulative) >= rank) return std::chrono::nanoseconds(bucketUpperBound(i));
+    }
+    return std::chrono::nanoseconds(bucketUpperBound(kBuckets - 1));
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,22 @@
+#include <depthai_bridge/MotionBlurGate.hpp>
+
+namespace dai {
+
+namespace ros {
+
+MotionBlurGate::MotionBlurGate(std::shared_ptr<ImuSampleStore> imuStore, float maxRotation) : _imuStore(imuStore), _maxRotation(maxRotation) {}
+
+bool MotionBlurGate::estimateRotation(std::shared_ptr<dai::ImgFrame> inData, float& rotation) const {
+    const auto end = inData->getTimestamp();
+    const auto begin = end - inData->getExposureTime();
+    return _imuStore->integrateAngularSpeed(begin, end, rotation);
+}
+
+bool MotionBlurGate::isSharp(std::shared_ptr<dai::ImgFrame> inData) const {
+    float rotation = 0;
+    if(!estimateRotation(inData, rotation)) return true;
+    return rotation <= _maxRotation;
+}
+
+}  // namespace ros
+}  // namespace dai
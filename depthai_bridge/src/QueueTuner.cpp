@@ -0,0 +1,41 @@
+#include <algorithm>
+#include <depthai_bridge/QueueTuner.hpp>
+
+namespace dai {
+
+namespace ros {
+
+QueueTuner::QueueTuner(std::chrono::nanoseconds targetWait, unsigned maxSizeLimit, std::chrono::milliseconds interval)
+    : _targetWait(targetWait), _maxSizeLimit(std::max(1u, maxSizeLimit)), _interval(interval) {}
+
+bool QueueTuner::update(
+    std::chrono::steady_clock::time_point now, std::chrono::nanoseconds wait, unsigned depth, uint64_t overflowTotal, unsigned& maxSize, bool& blocking) {
+    if(!_started) {
+        _started = true;
+        _windowStart = now;
+        _windowOverflowStart = overflowTotal;
+    }
+    _samples++;
+    if(wait > _targetWait) _overTarget++;
+    if(depth > 0) _queuedUp++;
+    if(now - _windowStart < _interval) return false;
+
+    bool changed = false;
+    if(_overTarget * 20 > _samples && _queuedUp * 2 > _samples) {
+        const unsigned smaller = std::max(1u, maxSize / 2);
+        changed = smaller != maxSize || blocking;
+        maxSize = smaller;
+        blocking = false;
+    } else if(_overTarget == 0 && overflowTotal > _windowOverflowStart && maxSize < _maxSizeLimit) {
+        maxSize++;
+        changed = true;
+    }
+
+    _windowStart = now;
+    _windowOverflowStart = overflowTotal;
+    _samples = _overTarget = _queuedUp = 0;
+    return changed;
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,82 @@
+#include <algorithm>
+#include <cstdlib>
+#include <depthai_bridge/SceneChangeDetector.hpp>
+
+namespace dai {
+
+namespace ros {
+
+SceneChangeDetector::SceneChangeDetector(float threshold, std::chrono::milliseconds keepAlive, int gridWidth, int gridHeight)
+    : _threshold(threshold), _keepAlive(keepAlive), _gridWidth(std::max(gridWidth, 1)), _gridHeight(std::max(gridHeight, 1)) {
+    _reference.resize(_gridWidth * _gridHeight);
+    _current.resize(_gridWidth * _gridHeight);
+}
+
+float SceneChangeDetector::getLastDifference() const {
+    return _lastDifference;
+}
+
+bool SceneChangeDetector::computeSignature(std::shared_ptr<dai::ImgFrame> inData, std::vector<uint8_t>& signature) const {
+    int pixelStride = 1;
+    switch(inData->getType()) {
+        case dai::RawImgFrame::Type::NV12:
+        case dai::RawImgFrame::Type::YUV420p:
+        case dai::RawImgFrame::Type::GRAY8:
+        case dai::RawImgFrame::Type::RAW8:
+        case dai::RawImgFrame::Type::BGR888p:
+        case dai::RawImgFrame::Type::RGB888p:
+            break;
+        case dai::RawImgFrame::Type::BGR888i:
+        case dai::RawImgFrame::Type::RGB888i:
+            pixelStride = 3;
+            break;
+        default:
+            return false;
+    }
+
+    const int width = inData->getWidth(), height = inData->getHeight();
+    const size_t rowBytes = static_cast<size_t>(width) * pixelStride;
+    if(width < 4 || height < 4 || inData->getData().size() < rowBytes * height) return false;
+
+    // A 4x4 block average per cell is far less sensitive to sensor noise than single pixels and costs ~37k reads at the default grid
+    const uint8_t* data = inData->getData().data();
+    for(int gy = 0; gy < _gridHeight; ++gy) {
+        const int y = std::min(gy * height / _gridHeight, height - 4);
+        for(int gx = 0; gx < _gridWidth; ++gx) {
+            const int x = std::min(gx * width / _gridWidth, width - 4);
+            uint32_t sum = 0;
+            for(int by = 0; by < 4; ++by) {
+                const uint8_t* line = data + (y + by) * rowBytes + static_cast<size_t>(x) * pixelStride;
+                sum += line[0] + line[pixelStride] + line[2 * pixelStride] + line[3 * pixelStride];
+            }
+            signature[gy * _gridWidth + gx] = static_cast<uint8_t>(sum >> 4);
+        }
+    }
+    return true;
+}
+
+bool SceneChangeDetector::hasChanged(std::shared_ptr<dai::ImgFrame> inData) {
+    if(!computeSignature(inData, _current)) return true;
+
+    const auto timestamp = inData->getTimestamp();
+    bool publish = !_hasReference || timestamp - _lastPublished >= _keepAlive;
+    if(_hasReference) {
+        uint32_t sad = 0;
+        for(size_t i = 0; i < _current.size(); ++i) {
+            sad += std::abs(static_cast<int>(_current[i]) - static_cast<int>(_reference[i]));
+        }
+        _lastDifference = static_cast<float>(sad) / _current.size();
+        publish = publish || _lastDifference > _threshold;
+    }
+
+    // The reference is the last published frame, so a slow drift still adds up to a change eventually
+    if(publish) {
+        std::swap(_reference, _current);
+        _lastPublished = timestamp;
+        _hasReference = true;
+    }
+    return publish;
+}
+
+}  // namespace ros
+}  // namespace dai
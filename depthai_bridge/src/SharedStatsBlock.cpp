@@ -0,0 +1,146 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <depthai_bridge/SharedStatsBlock.hpp>
+#include <new>
+#include <stdexcept>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x44425354;  // "DBST"
+constexpr uint32_t kVersion = 2;
+
+std::runtime_error shmError(const std::string& what, const std::string& name) {
+    return std::runtime_error(what + " shared memory segment " + name + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+struct alignas(64) SharedStatsBlock::Header {
+    uint32_t magic;
+    uint32_t version;
+    int32_t pid;
+    uint32_t maxStreams;
+    // Published after the record's name is written
+    std::atomic<uint32_t> streamCount;
+};
+
+StreamStatsRecord::StreamStatsRecord()
+    : arrived(0),
+      lostBeforeHost(0),
+      received(0),
+      missingAtReader(0),
+      sequenceGaps(0),
+      filtered(0),
+      noSubscriber(0),
+      published(0),
+      cpuTimeNs(0) {
+    std::memset(name, 0, kNameSize);
+    for(auto& count : queueDepth) count.store(0, std::memory_order_relaxed);
+}
+
+SharedStatsBlock::SharedStatsBlock(uint32_t maxStreams) : _name(kNamePrefix + std::to_string(getpid())), _owner(true) {
+    shm_unlink(_name.c_str());
+    int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+    if(fd < 0) throw shmError("Failed to create", _name);
+
+    const size_t size = sizeof(Header) + maxStreams * sizeof(StreamStatsRecord);
+    if(ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(_name.c_str());
+        throw shmError("Failed to size", _name);
+    }
+    _base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if(_base == MAP_FAILED) {
+        _base = nullptr;
+        shm_unlink(_name.c_str());
+        throw shmError("Failed to map", _name);
+    }
+    _mappedSize = size;
+
+    _header = new(_base) Header;
+    _header->magic = kMagic;
+    _header->version = kVersion;
+    _header->pid = static_cast<int32_t>(getpid());
+    _header->maxStreams = maxStreams;
+    _header->streamCount.store(0, std::memory_order_release);
+    _records = reinterpret_cast<StreamStatsRecord*>(static_cast<uint8_t*>(_base) + sizeof(Header));
+}
+
+SharedStatsBlock::SharedStatsBlock(const std::string& name) : _name(name), _owner(false) {
+    int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+    if(fd < 0) throw shmError("Failed to open", _name);
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(Header)) {
+        close(fd);
+        throw std::runtime_error("Shared memory segment " + _name + " is not a bridge stats block");
+    }
+    _base = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(_base == MAP_FAILED) {
+        _base = nullptr;
+        throw shmError("Failed to map", _name);
+    }
+    _mappedSize = static_cast<size_t>(info.st_size);
+
+    _header = static_cast<Header*>(_base);
+    if(_header->magic != kMagic || _header->version != kVersion || sizeof(Header) + _header->maxStreams * sizeof(StreamStatsRecord) > _mappedSize) {
+        munmap(_base, _mappedSize);
+        throw std::runtime_error("Shared memory segment " + _name + " is not a bridge stats block of this version");
+    }
+    _records = reinterpret_cast<StreamStatsRecord*>(static_cast<uint8_t*>(_base) + sizeof(Header));
+}
+
+SharedStatsBlock::~SharedStatsBlock() {
+    if(_base != nullptr) munmap(_base, _mappedSize);
+    if(_owner) shm_unlink(_name.c_str());
+}
+
+StreamStatsRecord* SharedStatsBlock::addStream(const std::string& name) {
+    if(!_owner) throw std::runtime_error("Shared memory segment " + _name + " is mapped read only");
+
+    std::lock_guard<std::mutex> lock(_addMutex);
+    const uint32_t index = _header->streamCount.load(std::memory_order_relaxed);
+    if(index >= _header->maxStreams) throw std::runtime_error("Bridge stats block " + _name + " is full");
+
+    StreamStatsRecord* record = new(&_records[index]) StreamStatsRecord;
+    std::strncpy(record->name, name.c_str(), StreamStatsRecord::kNameSize - 1);
+    _header->streamCount.store(index + 1, std::memory_order_release);
+    return record;
+}
+
+uint32_t SharedStatsBlock::getStreamCount() const {
+    return _header->streamCount.load(std::memory_order_acquire);
+}
+
+const StreamStatsRecord& SharedStatsBlock::getStream(uint32_t index) const {
+    return _records[index];
+}
+
+int SharedStatsBlock::getPid() const {
+    return _header->pid;
+}
+
+const std::string& SharedStatsBlock::getName() const {
+    return _name;
+}
+
+std::chrono::nanoseconds threadCpuTime() {
+    timespec time;
+    if(clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) return std::chrono::nanoseconds(0);
+    return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+}
+
+}  // namespace ros
+}  // namespace dai
@@ -0,0 +1,163 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <depthai_bridge/ShmImageRing.hpp>
+#include <new>
+#include <stdexcept>
+
+namespace dai {
+
+namespace ros {
+
+namespace {
+
+constexpr uint32_t kMagic = 0x44534852;  // "DSHR"
+constexpr size_t kAlignment = 64;
+
+size_t alignUp(size_t size) {
+    return (size + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+std::runtime_error shmError(const std::string& what, const std::string& name) {
+    return std::runtime_error(what + " shared memory segment " + name + ": " + std::strerror(errno));
+}
+
+}  // namespace
+
+struct alignas(kAlignment) ShmImageRing::SegmentHeader {
+    uint32_t magic;
+    uint32_t slotCount;
+    uint64_t slotSize;
+    std::atomic<uint64_t> writeCount;
+};
+
+struct alignas(kAlignment) ShmImageRing::SlotHeader {
+    // Odd while the writer fills the slot
+    std::atomic<uint64_t> sequence;
+    std::atomic<uint64_t> size;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "Sequence counters in shared memory have to be lock free");
+
+ShmImageRing::ShmImageRing(const std::string& name, uint32_t slotCount, size_t slotSize) : _name(name), _writer(true) {
+    if(slotCount == 0) throw std::runtime_error("Shared memory ring " + name + " needs at least one slot");
+
+    shm_unlink(_name.c_str());
+    int fd = shm_open(_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if(fd < 0) throw shmError("Failed to create", _name);
+
+    const size_t alignedSlotSize = alignUp(slotSize);
+    const size_t size = sizeof(SegmentHeader) + slotCount * (sizeof(SlotHeader) + alignedSlotSize);
+    if(ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(_name.c_str());
+        throw shmError("Failed to size", _name);
+    }
+    map(fd, size, true);
+
+    _header = new(_base) SegmentHeader;
+    _header->magic = kMagic;
+    _header->slotCount = slotCount;
+    _header->slotSize = alignedSlotSize;
+    _header->writeCount.store(0, std::memory_order_relaxed);
+    for(uint32_t i = 0; i < slotCount; ++i) {
+        SlotHeader* slot = new(slotHeader(i)) SlotHeader;
+        slot->sequence.store(0, std::memory_order_relaxed);
+        slot->size.store(0, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+ShmImageRing::ShmImageRing(const std::string& name) : _name(name), _writer(false) {
+    int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+    if(fd < 0) throw shmError("Failed to open", _name);
+
+    struct stat info;
+    if(fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(SegmentHeader)) {
+        close(fd);
+        throw std::runtime_error("Shared memory segment " + _name + " is not an image ring");
+    }
+    map(fd, static_cast<size_t>(info.st_size), false);
+
+    _header = reinterpret_cast<SegmentHeader*>(_base);
+    const size_t expected = sizeof(SegmentHeader) + _header->slotCount * (sizeof(SlotHeader) + _header->slotSize);
+    if(_header->magic != kMagic || expected > _mappedSize) {
+        munmap(_base, _mappedSize);
+        throw std::runtime_error("Shared memory segment " + _name + " is not an image ring");
+    }
+}
+
+ShmImageRing::~ShmImageRing() {
+    if(_base != nullptr) munmap(_base, _mappedSize);
+    if(_writer) shm_unlink(_name.c_str());
+}
+
+void ShmImageRing::map(int fd, size_t size, bool writable) {
+    void* base = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if(base == MAP_FAILED) {
+        if(writable) shm_unlink(_name.c_str());
+        throw shmError("Failed to map", _name);
+    }
+    _base = static_cast<uint8_t*>(base);
+    _mappedSize = size;
+}
+
+ShmImageRing::SlotHeader* ShmImageRing::slotHeader(uint32_t index) const {
+    return reinterpret_cast<SlotHeader*>(_base + sizeof(SegmentHeader) + index * (sizeof(SlotHeader) + _header->slotSize));
+}
+
+uint8_t* ShmImageRing::slotData(uint32_t index) const {
+    return reinterpret_cast<uint8_t*>(slotHeader(index)) + sizeof(SlotHeader);
+}
+
+ShmImageRing::Slot ShmImageRing::write(const uint8_t* data, size_t size) {
+    if(!_writer) throw std::runtime_error("Shared memory segment " + _name + " is mapped read only");
+    if(size > _header->slotSize) throw std::runtime_error("Frame of " + std::to_string(size) + " bytes does not fit the slots of " + _name);
+
+    const uint64_t count = _header->writeCount.load(std::memory_order_relaxed);
+    const uint32_t index = static_cast<uint32_t>(count % _header->slotCount);
+    SlotHeader* slot = slotHeader(index);
+
+    const uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    std::memcpy(slotData(index), data, size);
+    slot->size.store(size, std::memory_order_relaxed);
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+
+    _header->writeCount.store(count + 1, std::memory_order_release);
+    return {index, sequence + 2};
+}
+
+const uint8_t* ShmImageRing::view(const Slot& slot, size_t& size) const {
+    if(slot.index >= _header->slotCount) return nullptr;
+    const SlotHeader* header = slotHeader(slot.index);
+    if(header->sequence.load(std::memory_order_acquire) != slot.sequence) return nullptr;
+    // Clamped, a concurrent rewrite could leave any value here until isValid() rejects the view
+    size = std::min<size_t>(header->size.load(std::memory_order_relaxed), _header->slotSize);
+    return slotData(slot.index);
+}
+
+bool ShmImageRing::isValid(const Slot& slot) const {
+    if(slot.index >= _header->slotCount) return false;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slotHeader(slot.index)->sequence.load(std::memory_order_relaxed) == slot.sequence;
+}
+
+const std::string& ShmImageRing::getName() const {
+    return _name;
+}
+
+size_t ShmImageRing::getSlotSize() const {
+    return _header->slotSize;
+}
+
+}  // namespace ros
+}  // namespace dai
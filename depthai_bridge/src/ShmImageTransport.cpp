@@ -0,0 +1,99 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <depthai_bridge/ShmImageTransport.hpp>
+
+#ifdef IS_ROS2
+    #include <pluginlib/class_list_macros.hpp>
+
+    #include "rclcpp/rclcpp.hpp"
+#else
+    #include <pluginlib/class_list_macros.h>
+    #include <ros/console.h>
+
+    #include <boost/make_shared.hpp>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+std::string ShmPublisher::getTransportName() const {
+    return "shm";
+}
+
+void ShmPublisher::publish(const ImageMsgs::Image& message, const PublishFn& publishFn) const {
+    std::lock_guard<std::mutex> lock(_ringMutex);
+    const size_t size = message.data.size();
+    if(!_ring || _ring->getSlotSize() < size) {
+        // A new segment per size change, subscribers follow the name in the descriptor
+        std::string name = getTopic();
+        std::replace(name.begin(), name.end(), '/', '_');
+        name = "/depthai_" + std::to_string(getpid()) + name + "_" + std::to_string(_generation++);
+        _ring.reset();
+        _ring.reset(new ShmImageRing(name, kSlotCount, size));
+    }
+
+    const auto slot = _ring->write(message.data.data(), size);
+
+    DepthaiMsgs::ShmImageDescriptor descriptor;
+    descriptor.header = message.header;
+    descriptor.segment = _ring->getName();
+    descriptor.slot = slot.index;
+    descriptor.sequence = slot.sequence;
+    descriptor.height = message.height;
+    descriptor.width = message.width;
+    descriptor.encoding = message.encoding;
+    descriptor.is_bigendian = message.is_bigendian;
+    descriptor.step = message.step;
+    descriptor.size = static_cast<uint32_t>(size);
+    publishFn(descriptor);
+}
+
+std::string ShmSubscriber::getTransportName() const {
+    return "shm";
+}
+
+void ShmSubscriber::internalCallback(const ShmImageDescriptorConstPtr& message, const Callback& userCallback) {
+    try {
+        if(!_ring || _ring->getName() != message->segment) {
+            _ring.reset();
+            _ring.reset(new ShmImageRing(message->segment));
+        }
+    } catch(const std::runtime_error& e) {
+#ifdef IS_ROS2
+        RCLCPP_WARN(rclcpp::get_logger("ShmSubscriber"), "%s", e.what());
+#else
+        ROS_WARN_NAMED("ShmSubscriber", "%s", e.what());
+#endif
+        return;
+    }
+
+    const ShmImageRing::Slot slot{message->slot, message->sequence};
+    size_t size = 0;
+    const uint8_t* data = _ring->view(slot, size);
+    if(data == nullptr || size < message->size) return;
+
+#ifdef IS_ROS2
+    auto image = std::make_shared<ImageMsgs::Image>();
+#else
+    auto image = boost::make_shared<ImageMsgs::Image>();
+#endif
+    image->header = message->header;
+    image->height = message->height;
+    image->width = message->width;
+    image->encoding = message->encoding;
+    image->is_bigendian = message->is_bigendian;
+    image->step = message->step;
+    image->data.assign(data, data + message->size);
+
+    // The publisher got round to the slot again while it was copied, the copy may be torn
+    if(!_ring->isValid(slot)) return;
+    userCallback(image);
+}
+
+}  // namespace ros
+}  // namespace dai
+
+PLUGINLIB_EXPORT_CLASS(dai::ros::ShmPublisher, image_transport::PublisherPlugin)
+PLUGINLIB_EXPORT_CLASS(dai::ros::ShmSubscriber, image_transport::SubscriberPlugin)
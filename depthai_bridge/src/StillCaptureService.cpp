@@ -0,0 +1,35 @@
+#include <depthai_bridge/StillCaptureService.hpp>
+
+namespace dai {
+
+namespace ros {
+
+#ifdef IS_ROS2
+StillCaptureService::StillCaptureService(std::shared_ptr<rclcpp::Node> node, std::string serviceName, std::shared_ptr<CameraControlBridge> controlBridge)
+    : _node(node), _controlBridge(controlBridge) {
+    _captureService = _node->create_service<DepthaiSrvs::TriggerNamed>(
+        serviceName, std::bind(&StillCaptureService::captureCallback, this, std::placeholders::_1, std::placeholders::_2));
+}
+
+void StillCaptureService::captureCallback(const std::shared_ptr<DepthaiSrvs::TriggerNamed::Request> request,
+                                          std::shared_ptr<DepthaiSrvs::TriggerNamed::Response> response) {
+    _controlBridge->captureStill();
+    response->success = true;
+    response->message = "Still capture '" + request->name + "' requested";
+}
+#else
+StillCaptureService::StillCaptureService(::ros::NodeHandle nh, std::string serviceName, std::shared_ptr<CameraControlBridge> controlBridge)
+    : _nh(nh), _controlBridge(controlBridge) {
+    _captureService = _nh.advertiseService(serviceName, &StillCaptureService::captureCallback, this);
+}
+
+bool StillCaptureService::captureCallback(DepthaiSrvs::TriggerNamed::Request& request, DepthaiSrvs::TriggerNamed::Response& response) {
+    _controlBridge->captureStill();
+    response.success = true;
+    response.message = "Still capture '" + request.name + "' requested";
+    return true;
+}
+#endif
+
+}  // namespace ros
+}  // namespace dai
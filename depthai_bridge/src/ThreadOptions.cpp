@@ -0,0 +1,66 @@
+#include <depthai_bridge/ThreadOptions.hpp>
+#include <stdexcept>
+#include <string>
+
+#ifdef __linux__
+    #include <alloca.h>
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+
+    #include <cerrno>
+    #include <cstring>
+#endif
+
+namespace dai {
+
+namespace ros {
+
+#ifdef __linux__
+namespace {
+
+void throwError(const std::string& what, int error) {
+    throw std::runtime_error(what + ": " + std::strerror(error));
+}
+
+}  // namespace
+
+void applyThreadOptions(const ThreadOptions& options) {
+    if(options.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        throwError("mlockall failed", errno);
+    }
+
+    if(!options.cpuAffinity.empty()) {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        for(int cpu : options.cpuAffinity) {
+            if(cpu < 0 || cpu >= CPU_SETSIZE) throw std::runtime_error("Invalid CPU index " + std::to_string(cpu) + " in the affinity mask");
+            CPU_SET(cpu, &cpuSet);
+        }
+        int error = pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+        if(error != 0) throwError("Setting the CPU affinity failed", error);
+    }
+
+    if(options.fifoPriority != 0) {
+        sched_param param{};
+        param.sched_priority = options.fifoPriority;
+        int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if(error != 0) throwError("Setting SCHED_FIFO priority " + std::to_string(options.fifoPriority) + " failed", error);
+    }
+
+    if(options.prefaultStackBytes > 0) {
+        // Released when this function returns, the pages stay mapped (and locked with lockMemory)
+        volatile char* stack = static_cast<volatile char*>(alloca(options.prefaultStackBytes));
+        for(size_t i = 0; i < options.prefaultStackBytes; i += 4096) {
+            stack[i] = 0;
+        }
+    }
+}
+#else
+void applyThreadOptions(const ThreadOptions& options) {
+    if(!options.isDefault()) throw std::runtime_error("Real time thread options are only supported on Linux");
+}
+#endif
+
+}  // namespace ros
+}  // namespace dai
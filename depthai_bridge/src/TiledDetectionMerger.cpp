@@ -0,0 +1,169 @@
+#include <algorithm>
+#include <depthai_bridge/TiledDetectionMerger.hpp>
+#include <numeric>
+
+namespace dai {
+
+namespace ros {
+
+TiledDetectionMerger::TiledDetectionMerger(std::string frameName, int width, int height, std::vector<dai::Rect> tiles, float iouThreshold, bool normalized)
+    : _sequenceNum(0), _width(width), _height(height), _frameName(frameName), _normalized(normalized), _tiles(tiles), _iouThreshold(iouThreshold) {}
+
+void TiledDetectionMerger::toRosMsg(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData,
+                                    VisionMsgs::Detection2DArray& opDetectionMsg,
+                                    TimePoint tStamp,
+                                    int32_t sequenceNum) {
+    toRosMsg(inTileData, opDetectionMsg);
+    int32_t sec = std::chrono::duration_cast<std::chrono::seconds>(tStamp.time_since_epoch()).count();
+    int32_t nsec = std::chrono::duration_cast<std::chrono::nanoseconds>(tStamp.time_since_epoch()).count() % 1000000000UL;
+#ifndef IS_ROS2
+    if(sequenceNum != -1) _sequenceNum = sequenceNum;
+    opDetectionMsg.header.seq = _sequenceNum;
+    opDetectionMsg.header.stamp = ::ros::Time(sec, nsec);
+#else
+    opDetectionMsg.header.stamp = rclcpp::Time(sec, nsec);
+#endif
+
+    opDetectionMsg.header.frame_id = _frameName;
+}
+
+void TiledDetectionMerger::toRosMsg(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData, VisionMsgs::Detection2DArray& opDetectionMsg) {
+// setting the header
+#ifndef IS_ROS2
+    opDetectionMsg.header.seq = _sequenceNum;
+    _sequenceNum++;
+    opDetectionMsg.header.stamp = ::ros::Time::now();
+#else
+    opDetectionMsg.header.stamp = rclcpp::Clock().now();
+#endif
+
+    opDetectionMsg.header.frame_id = _frameName;
+
+    remapTiles(inTileData);
+    suppress();
+
+    const float xScale = _normalized ? 1.0f : static_cast<float>(_width);
+    const float yScale = _normalized ? 1.0f : static_cast<float>(_height);
+
+    opDetectionMsg.detections.resize(_keep.size());
+    for(size_t k = 0; k < _keep.size(); ++k) {
+        const uint32_t i = _keep[k];
+        float xSize = (_xMax[i] - _xMin[i]) * xScale;
+        float ySize = (_yMax[i] - _yMin[i]) * yScale;
+        float xCenter = _xMin[i] * xScale + xSize / 2;
+        float yCenter = _yMin[i] * yScale + ySize / 2;
+
+        opDetectionMsg.detections[k].results.resize(1);
+
+#ifdef IS_GALACTIC
+        opDetectionMsg.detections[k].id = std::to_string(_label[i]);
+        opDetectionMsg.detections[k].results[0].hypothesis.class_id = std::to_string(_label[i]);
+        opDetectionMsg.detections[k].results[0].hypothesis.score = _score[i];
+#elif IS_ROS2
+        opDetectionMsg.detections[k].results[0].id = std::to_string(_label[i]);
+        opDetectionMsg.detections[k].results[0].score = _score[i];
+#else
+        opDetectionMsg.detections[k].results[0].id = _label[i];
+        opDetectionMsg.detections[k].results[0].score = _score[i];
+#endif
+        opDetectionMsg.detections[k].bbox.center.x = xCenter;
+        opDetectionMsg.detections[k].bbox.center.y = yCenter;
+        opDetectionMsg.detections[k].bbox.size_x = xSize;
+        opDetectionMsg.detections[k].bbox.size_y = ySize;
+    }
+}
+
+Detection2DArrayPtr TiledDetectionMerger::toRosMsgPtr(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData) {
+#ifdef IS_ROS2
+    Detection2DArrayPtr ptr = std::make_shared<VisionMsgs::Detection2DArray>();
+#else
+    Detection2DArrayPtr ptr = boost::make_shared<VisionMsgs::Detection2DArray>();
+#endif
+    toRosMsg(inTileData, *ptr);
+    return ptr;
+}
+
+void TiledDetectionMerger::remapTiles(const std::vector<std::shared_ptr<dai::ImgDetections>>& inTileData) {
+    if(inTileData.size() > _tiles.size()) {
+        throw std::runtime_error("TiledDetectionMerger received more tiles than it was configured with");
+    }
+
+    size_t count = 0;
+    for(const auto& tileData : inTileData) {
+        if(tileData != nullptr) count += tileData->detections.size();
+    }
+    _xMin.resize(count);
+    _yMin.resize(count);
+    _xMax.resize(count);
+    _yMax.resize(count);
+    _area.resize(count);
+    _score.resize(count);
+    _label.resize(count);
+
+    size_t i = 0;
+    for(size_t t = 0; t < inTileData.size(); ++t) {
+        if(inTileData[t] == nullptr) continue;
+        const dai::Rect& tile = _tiles[t];
+        for(const auto& detection : inTileData[t]->detections) {
+            // Tile local normalized box -> normalized full frame box
+            _xMin[i] = std::min(std::max(tile.x + detection.xmin * tile.width, 0.0f), 1.0f);
+            _yMin[i] = std::min(std::max(tile.y + detection.ymin * tile.height, 0.0f), 1.0f);
+            _xMax[i] = std::min(std::max(tile.x + detection.xmax * tile.width, 0.0f), 1.0f);
+            _yMax[i] = std::min(std::max(tile.y + detection.ymax * tile.height, 0.0f), 1.0f);
+            _area[i] = (_xMax[i] - _xMin[i]) * (_yMax[i] - _yMin[i]);
+            _score[i] = detection.confidence;
+            _label[i] = detection.label;
+            ++i;
+        }
+    }
+}
+
+void TiledDetectionMerger::suppress() {
+    const size_t count = _score.size();
+    _order.resize(count);
+    std::iota(_order.begin(), _order.end(), 0);
+    // Group by label and sort every group by descending score, the suppression below is then a single pass per group.
+    std::sort(_order.begin(), _order.end(), [this](uint32_t a, uint32_t b) {
+        if(_label[a] != _label[b]) return _label[a] < _label[b];
+        return _score[a] > _score[b];
+    });
+
+    _keep.clear();
+    size_t begin = 0;
+    while(begin < count) {
+        const uint32_t label = _label[_order[begin]];
+        _keptXMin.clear();
+        _keptYMin.clear();
+        _keptXMax.clear();
+        _keptYMax.clear();
+        _keptArea.clear();
+
+        size_t end = begin;
+        for(; end < count && _label[_order[end]] == label; ++end) {
+            const uint32_t i = _order[end];
+            const float xMin = _xMin[i], yMin = _yMin[i], xMax = _xMax[i], yMax = _yMax[i], area = _area[i];
+
+            // A candidate only competes with the higher scored boxes of its label that survived
+            float maxIou = 0;
+            for(size_t k = 0; k < _keptArea.size(); ++k) {
+                float w = std::max(std::min(xMax, _keptXMax[k]) - std::max(xMin, _keptXMin[k]), 0.0f);
+                float h = std::max(std::min(yMax, _keptYMax[k]) - std::max(yMin, _keptYMin[k]), 0.0f);
+                float intersection = w * h;
+                float iou = intersection / std::max(area + _keptArea[k] - intersection, 1e-12f);
+                maxIou = std::max(maxIou, iou);
+            }
+            if(maxIou > _iouThreshold) continue;
+
+            _keep.push_back(i);
+            _keptXMin.push_back(xMin);
+            _keptYMin.push_back(yMin);
+            _keptXMax.push_back(xMax);
+            _keptYMax.push_back(yMax);
+            _keptArea.push_back(area);
+        }
+        begin = end;
+    }
+}
+
+}  // namespace ros
+}  // namespace dai
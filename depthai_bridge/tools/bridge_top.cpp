@@ -0,0 +1,197 @@
+// Live per stream view of the stats BridgePublishers export with exportStats(), read from shared memory.
+// usage: bridge_top [--interval <seconds>] [--once] [segment...]
+// Without segments every /dev/shm/depthai_bridge_stats_<pid> block is shown, including ones created later.
+
+#include <dirent.h>
+#include <signal.h>
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <depthai_bridge/SharedStatsBlock.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using dai::ros::LatencyHistogram;
+using dai::ros::SharedStatsBlock;
+using dai::ros::StreamStatsRecord;
+
+namespace {
+
+struct Snapshot {
+    uint64_t received = 0, published = 0, lost = 0, overflow = 0, noSubscriber = 0, cpuTimeNs = 0;
+    LatencyHistogram::Counts conversionTime{}, latency{}, queueWait{};
+    std::array<uint64_t, StreamStatsRecord::kQueueDepthBuckets> queueDepth{};
+};
+
+struct Block {
+    std::unique_ptr<SharedStatsBlock> stats;
+    std::vector<Snapshot> previous;
+};
+
+Snapshot takeSnapshot(const StreamStatsRecord& record) {
+    Snapshot snapshot;
+    snapshot.received = record.received.load(std::memory_order_relaxed);
+    snapshot.published = record.published.load(std::memory_order_relaxed);
+    const uint64_t lostBeforeHost = record.lostBeforeHost.load(std::memory_order_relaxed);
+    const uint64_t missingAtReader = record.missingAtReader.load(std::memory_order_relaxed);
+    const uint64_t arrived = record.arrived.load(std::memory_order_relaxed);
+    // Without an arrival callback (callback mode) every gap is counted as lost before the host
+    snapshot.lost = arrived > 0 ? lostBeforeHost : missingAtReader;
+    snapshot.overflow = arrived > 0 && missingAtReader > lostBeforeHost ? missingAtReader - lostBeforeHost : 0;
+    snapshot.noSubscriber = record.noSubscriber.load(std::memory_order_relaxed);
+    snapshot.cpuTimeNs = record.cpuTimeNs.load(std::memory_order_relaxed);
+    snapshot.conversionTime = record.conversionTime.getCounts();
+    snapshot.latency = record.latency.getCounts();
+    snapshot.queueWait = record.queueWait.getCounts();
+    for(size_t i = 0; i < snapshot.queueDepth.size(); ++i) snapshot.queueDepth[i] = record.queueDepth[i].load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+LatencyHistogram::Counts difference(const LatencyHistogram::Counts& current, const LatencyHistogram::Counts& previous) {
+    LatencyHistogram::Counts delta;
+    for(size_t i = 0; i < delta.size(); ++i) delta[i] = current[i] - previous[i];
+    return delta;
+}
+
+// Queue depth holding the given fraction of the dequeued messages in the interval, the last bucket reads as its lower bound
+size_t depthPercentile(const std::array<uint64_t, StreamStatsRecord::kQueueDepthBuckets>& current,
+                       const std::array<uint64_t, StreamStatsRecord::kQueueDepthBuckets>& previous,
+                       double fraction) {
+    uint64_t total = 0;
+    for(size_t i = 0; i < current.size(); ++i) total += current[i] - previous[i];
+    uint64_t seen = 0;
+    for(size_t i = 0; i < current.size(); ++i) {
+        seen += current[i] - previous[i];
+        if(total > 0 && seen >= fraction * total) return i;
+    }
+    return 0;
+}
+
+double milliseconds(std::chrono::nanoseconds value) {
+    return value.count() / 1e6;
+}
+
+bool processAlive(int pid) {
+    return kill(pid, 0) == 0 || errno == EPERM;
+}
+
+std::vector<std::string> findSegments() {
+    std::vector<std::string> segments;
+    const std::string prefix = std::string(SharedStatsBlock::kNamePrefix).substr(1);
+    DIR* dir = opendir("/dev/shm");
+    if(dir == nullptr) return segments;
+    while(dirent* entry = readdir(dir)) {
+        if(std::strncmp(entry->d_name, prefix.c_str(), prefix.size()) == 0) segments.push_back("/" + std::string(entry->d_name));
+    }
+    closedir(dir);
+    return segments;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    double interval = 1.0;
+    bool once = false;
+    std::vector<std::string> requested;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--interval") == 0 && i + 1 < argc) {
+            interval = std::max(0.1, std::atof(argv[++i]));
+        } else if(std::strcmp(argv[i], "--once") == 0) {
+            once = true;
+        } else if(argv[i][0] == '-') {
+            std::fprintf(stderr, "usage: %s [--interval <seconds>] [--once] [segment...]\n", argv[0]);
+            return 1;
+        } else {
+            requested.push_back(argv[i][0] == '/' ? argv[i] : "/" + std::string(argv[i]));
+        }
+    }
+
+    std::map<std::string, Block> blocks;
+    auto lastTick = std::chrono::steady_clock::now();
+    bool first = true;
+    while(true) {
+        for(const auto& name : requested.empty() ? findSegments() : requested) {
+            if(blocks.count(name)) continue;
+            try {
+                blocks[name].stats.reset(new SharedStatsBlock(name));
+            } catch(const std::runtime_error& e) {
+                blocks.erase(name);
+                if(!requested.empty()) std::fprintf(stderr, "%s\n", e.what());
+            }
+        }
+
+        std::this_thread::sleep_for(std::chrono::duration<double>(first ? std::min(interval, 0.5) : interval));
+        const auto now = std::chrono::steady_clock::now();
+        const double elapsed = std::chrono::duration<double>(now - lastTick).count();
+        lastTick = now;
+
+        if(!first) {
+            if(!once) std::printf("\033[H\033[2J");
+            std::printf("%7s %-32s %7s %7s %8s %8s %8s %8s %8s %7s %8s %8s %8s %6s\n",
+                        "PID",
+                        "STREAM",
+                        "IN/s",
+                        "PUB/s",
+                        "CONV50",
+                        "CONV99",
+                        "LAT50",
+                        "LAT99",
+                        "WAIT99",
+                        "DEPTH99",
+                        "LOST",
+                        "OVERFLOW",
+                        "NOSUB",
+                        "CPU%");
+        }
+        for(auto it = blocks.begin(); it != blocks.end();) {
+            Block& block = it->second;
+            if(!processAlive(block.stats->getPid())) {
+                it = blocks.erase(it);
+                continue;
+            }
+            const uint32_t streams = block.stats->getStreamCount();
+            // Streams and segments that appeared since the last tick have no previous snapshot yet
+            const size_t sampled = block.previous.size();
+            block.previous.resize(streams);
+            for(uint32_t i = 0; i < streams; ++i) {
+                const StreamStatsRecord& record = block.stats->getStream(i);
+                const Snapshot current = takeSnapshot(record);
+                const Snapshot& previous = block.previous[i];
+                const auto conversionTime = difference(current.conversionTime, previous.conversionTime);
+                const auto latency = difference(current.latency, previous.latency);
+                const auto queueWait = difference(current.queueWait, previous.queueWait);
+                // A first snapshot only holds totals since the stream started, rates need two samples
+                if(i < sampled) {
+                    std::printf("%7d %-32.32s %7.1f %7.1f %8.2f %8.2f %8.2f %8.2f %8.2f %7zu %8llu %8llu %8llu %6.1f\n",
+                                block.stats->getPid(),
+                                record.name,
+                                (current.received - previous.received) / elapsed,
+                                (current.published - previous.published) / elapsed,
+                                milliseconds(LatencyHistogram::percentile(conversionTime, 0.5)),
+                                milliseconds(LatencyHistogram::percentile(conversionTime, 0.99)),
+                                milliseconds(LatencyHistogram::percentile(latency, 0.5)),
+                                milliseconds(LatencyHistogram::percentile(latency, 0.99)),
+                                milliseconds(LatencyHistogram::percentile(queueWait, 0.99)),
+                                depthPercentile(current.queueDepth, previous.queueDepth, 0.99),
+                                static_cast<unsigned long long>(current.lost),
+                                static_cast<unsigned long long>(current.overflow),
+                                static_cast<unsigned long long>(current.noSubscriber),
+                                100.0 * (current.cpuTimeNs - previous.cpuTimeNs) / 1e9 / elapsed);
+                }
+                block.previous[i] = current;
+            }
+            ++it;
+        }
+        std::fflush(stdout);
+        if(once && !first) break;
+        first = false;
+    }
+    return 0;
+}
@@ -0,0 +1,286 @@
+// Converter micro-benchmarks on synthetic frames, and ImuSampleStore query cases, compared against a stored baseline.
+// Needs no device.
+// usage: converter_bench [--baseline <file>] [--tolerance <fraction>] [--update]
+// Exits with 1 if a case got slower, or allocates or page faults more per frame, than its baseline plus the tolerance
+// (default 15 %).
+// Baselines are machine specific: record them with --update on the machine the comparison runs on.
+// Configuring with -DCONVERTER_BENCH_BASELINE=<file> registers the comparison as the converter_bench ctest test.
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <depthai_bridge/DepthColorConverter.hpp>
+#include <depthai_bridge/DisparityConverter.hpp>
+#include <depthai_bridge/HugePageBuffer.hpp>
+#include <depthai_bridge/ImageConverter.hpp>
+#include <depthai_bridge/ImuSampleStore.hpp>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "depthai/depthai.hpp"
+
+namespace {
+
+std::atomic<uint64_t> allocations(0);
+
+struct Result {
+    double nsPerFrame;
+    double allocationsPerFrame;
+    double faultsPerFrame;
+};
+
+// Page faults of the calling thread so far, minor (first touch of fresh memory) and major
+uint64_t pageFaults() {
+    rusage usage;
+    getrusage(RUSAGE_THREAD, &usage);
+    return usage.ru_minflt + usage.ru_majflt;
+}
+
+std::shared_ptr<dai::ImgFrame> syntheticFrame(dai::RawImgFrame::Type type, unsigned width, unsigned height, size_t bytes) {
+    std::vector<uint8_t> data(bytes);
+    // A gradient rather than zeros, so no path can take a shortcut on uniform input
+    for(size_t i = 0; i < bytes; ++i) data[i] = static_cast<uint8_t>((i * 7) ^ (i >> 11));
+    auto frame = std::make_shared<dai::ImgFrame>();
+    frame->setWidth(width);
+    frame->setHeight(height);
+    frame->setType(type);
+    frame->setData(data);
+    frame->setTimestamp(std::chrono::steady_clock::now());
+    return frame;
+}
+
+// Best of several batches, the minimum is the most stable estimate on a shared machine
+Result run(const std::function<void()>& convertOnce) {
+    constexpr int kWarmup = 5, kBatches = 7, kFramesPerBatch = 20;
+    for(int i = 0; i < kWarmup; ++i) convertOnce();
+
+    double bestNs = 1e300;
+    uint64_t allocationsBefore = allocations.load();
+    const uint64_t faultsBefore = pageFaults();
+    for(int batch = 0; batch < kBatches; ++batch) {
+        const auto start = std::chrono::steady_clock::now();
+        for(int i = 0; i < kFramesPerBatch; ++i) convertOnce();
+        const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / kFramesPerBatch;
+        bestNs = std::min(bestNs, ns);
+    }
+    const double allocationsPerFrame = static_cast<double>(allocations.load() - allocationsBefore) / (kBatches * kFramesPerBatch);
+    const double faultsPerFrame = static_cast<double>(pageFaults() - faultsBefore) / (kBatches * kFramesPerBatch);
+    return {bestNs, allocationsPerFrame, faultsPerFrame};
+}
+
+// 1 kHz gyroscope samples of a slow wobble, filling a store of 4096 samples
+std::shared_ptr<dai::IMUData> syntheticImu(std::chrono::steady_clock::time_point start, int samples) {
+    auto imu = std::make_shared<dai::IMUData>();
+    imu->packets.resize(samples);
+    for(int i = 0; i < samples; ++i) {
+        const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(start.time_since_epoch()) + std::chrono::milliseconds(i);
+        auto& gyro = imu->packets[i].gyroscope;
+        gyro.timestamp.sec = timestamp.count() / 1000000000;
+        gyro.timestamp.nsec = timestamp.count() % 1000000000;
+        gyro.x = std::sin(i * 0.01f);
+        gyro.y = std::cos(i * 0.013f);
+        gyro.z = 0.1f;
+    }
+    return imu;
+}
+
+std::map<std::string, Result> readBaseline(const std::string& path) {
+    std::map<std::string, Result> baseline;
+    std::ifstream file(path);
+    std::string line;
+    while(std::getline(file, line)) {
+        if(line.empty() || line[0] == '#') continue;
+        std::istringstream fields(line);
+        std::string name;
+        Result result;
+        if(!(fields >> name >> result.nsPerFrame >> result.allocationsPerFrame)) continue;
+        // Baselines recorded before page faults were counted lack the column, and are not compared on it
+        if(!(fields >> result.faultsPerFrame)) result.faultsPerFrame = -1;
+        baseline[name] = result;
+    }
+    return baseline;
+}
+
+}  // namespace
+
+void* operator new(size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if(void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    std::free(ptr);
+}
+
+int main(int argc, char** argv) {
+    std::string baselinePath = "converter_bench_baseline.txt";
+    double tolerance = 0.15;
+    bool update = false;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if(std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else if(std::strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else {
+            std::fprintf(stderr, "usage: %s [--baseline <file>] [--tolerance <fraction>] [--update]\n", argv[0]);
+            return 2;
+        }
+    }
+
+#ifndef IS_ROS2
+    ::ros::Time::init();
+#endif
+
+    dai::ros::ImageConverter imageConverter("bench_frame", false);
+    dai::ros::ImageConverter claheConverter("bench_frame", false);
+    claheConverter.setEnhancement(dai::ros::ImageConverter::Enhancement::CLAHE);
+    dai::ros::DisparityConverter disparityConverter("bench_frame", 880, 7.5, 20, 2000);
+    dai::ros::DepthColorConverter depthColorConverter("bench_frame", dai::ros::DepthColorConverter::Source::DEPTH, 200, 10000);
+
+    auto nv12 = syntheticFrame(dai::RawImgFrame::Type::NV12, 1920, 1080, 1920 * 1080 * 3 / 2);
+    auto raw16 = syntheticFrame(dai::RawImgFrame::Type::RAW16, 1280, 720, 1280 * 720 * 2);
+    auto mono = syntheticFrame(dai::RawImgFrame::Type::RAW8, 1280, 800, 1280 * 800);
+    auto disparity = syntheticFrame(dai::RawImgFrame::Type::RAW8, 640, 400, 640 * 400);
+    auto bgr12mp = syntheticFrame(dai::RawImgFrame::Type::BGR888p, 4000, 3000, 4000 * 3000 * 3);
+
+    // Reused message as BridgePublisher::setReuseMessageBuffers(true) keeps it, moved to huge pages once it outgrows them
+    dai::ros::ImageMsgs::Image reusedMsg;
+    size_t hugePageBytes = 0;
+
+    // Queries at scattered times inside the stored history, 1000 per iteration since a single one takes nanoseconds
+    constexpr int kImuSamples = 4096, kImuQueries = 1000;
+    const auto imuStart = std::chrono::steady_clock::time_point(std::chrono::seconds(1000));
+    dai::ros::ImuSampleStore imuStore(kImuSamples);
+    imuStore.addImuData(syntheticImu(imuStart, kImuSamples));
+    std::vector<std::chrono::steady_clock::time_point> queryTimes(kImuQueries);
+    uint32_t seed = 12345;
+    for(auto& t : queryTimes) {
+        seed = seed * 1664525u + 1013904223u;
+        t = imuStart + std::chrono::milliseconds(20) + std::chrono::microseconds(seed % ((kImuSamples - 40) * 1000));
+    }
+    volatile float imuSink = 0;
+
+    // A fresh message per frame, as BridgePublisher does by default
+    std::vector<std::pair<std::string, std::function<void()>>> cases = {
+        {"image_nv12_1080p",
+         [&]() {
+             dai::ros::ImageMsgs::Image msg;
+             imageConverter.toRosMsg(nv12, msg);
+         }},
+        {"image_raw16_720p",
+         [&]() {
+             dai::ros::ImageMsgs::Image msg;
+             imageConverter.toRosMsg(raw16, msg);
+         }},
+        {"image_raw8_clahe_800p",
+         [&]() {
+             dai::ros::ImageMsgs::Image msg;
+             claheConverter.toRosMsg(mono, msg);
+         }},
+        {"image_bgr888p_12mp",
+         [&]() {
+             dai::ros::ImageMsgs::Image msg;
+             imageConverter.toRosMsg(bgr12mp, msg);
+         }},
+        {"image_bgr888p_12mp_reused",
+         [&]() {
+             imageConverter.toRosMsg(bgr12mp, reusedMsg);
+             if(reusedMsg.data.size() > hugePageBytes) {
+                 dai::ros::reserveHugePages(reusedMsg.data, reusedMsg.data.size());
+                 hugePageBytes = reusedMsg.data.capacity();
+             }
+         }},
+        {"disparity_raw8_400p",
+         [&]() {
+             dai::ros::DisparityMsgs::DisparityImage msg;
+             disparityConverter.toRosMsg(disparity, msg);
+         }},
+        {"depth_color_720p",
+         [&]() {
+             dai::ros::ImageMsgs::Image msg;
+             depthColorConverter.toRosMsg(raw16, msg);
+         }},
+        {"imu_angular_velocity_x1000",
+         [&]() {
+             dai::ros::ImuSampleStore::Vector3 velocity;
+             for(const auto& t : queryTimes) {
+                 if(imuStore.getAngularVelocity(t, velocity)) imuSink = imuSink + velocity.x;
+             }
+         }},
+        {"imu_angular_speed_10ms_x1000",
+         [&]() {
+             float angle;
+             for(const auto& t : queryTimes) {
+                 if(imuStore.integrateAngularSpeed(t - std::chrono::milliseconds(10), t, angle)) imuSink = imuSink + angle;
+             }
+         }},
+    };
+
+    const auto baseline = update ? std::map<std::string, Result>() : readBaseline(baselinePath);
+    if(!update && baseline.empty()) {
+        std::fprintf(stderr, "No baseline in %s, record one with --update\n", baselinePath.c_str());
+        return 2;
+    }
+
+    std::ostringstream updated;
+    updated << "# case ns_per_frame allocations_per_frame page_faults_per_frame\n";
+    bool regressed = false;
+    std::printf("%-28s %14s %14s %12s %12s %12s %12s  %s\n", "CASE", "NS/FRAME", "BASELINE", "ALLOCS", "BASELINE", "FAULTS", "BASELINE", "RESULT");
+    for(const auto& benchmark : cases) {
+        const Result result = run(benchmark.second);
+        updated << benchmark.first << " " << static_cast<uint64_t>(result.nsPerFrame) << " " << result.allocationsPerFrame << " " << result.faultsPerFrame << "\n";
+
+        auto reference = baseline.find(benchmark.first);
+        if(reference == baseline.end()) {
+            std::printf("%-28s %14.0f %14s %12.1f %12s %12.1f %12s  %s\n",
+                        benchmark.first.c_str(),
+                        result.nsPerFrame,
+                        "-",
+                        result.allocationsPerFrame,
+                        "-",
+                        result.faultsPerFrame,
+                        "-",
+                        update ? "recorded" : "no baseline");
+            continue;
+        }
+        const Result& expected = reference->second;
+        const bool slower = result.nsPerFrame > expected.nsPerFrame * (1 + tolerance);
+        const bool moreAllocations = result.allocationsPerFrame > expected.allocationsPerFrame * (1 + tolerance) + 0.5;
+        const bool moreFaults = expected.faultsPerFrame >= 0 && result.faultsPerFrame > expected.faultsPerFrame * (1 + tolerance) + 0.5;
+        regressed = regressed || slower || moreAllocations || moreFaults;
+        std::printf("%-28s %14.0f %14.0f %12.1f %12.1f %12.1f %12.1f  %s\n",
+                    benchmark.first.c_str(),
+                    result.nsPerFrame,
+                    expected.nsPerFrame,
+                    result.allocationsPerFrame,
+                    expected.allocationsPerFrame,
+                    result.faultsPerFrame,
+                    expected.faultsPerFrame,
+                    slower ? "SLOWER" : moreAllocations ? "MORE ALLOCATIONS" : moreFaults ? "MORE PAGE FAULTS" : "ok");
+    }
+
+    if(update) {
+        std::ofstream(baselinePath) << updated.str();
+        std::printf("Baseline written to %s\n", baselinePath.c_str());
+        return 0;
+    }
+    return regressed ? 1 : 0;
+}
@@ -0,0 +1,107 @@
+// Wake-up latency of a periodic thread running with ThreadOptions, optionally next to busy threads as synthetic load.
+// Needs no device, shows what setThreadOptions() buys for the BridgePublisher reading thread on this machine.
+// usage: thread_jitter_bench [--period-us <us>] [--periods <n>] [--fifo <priority>] [--cpu <n>]... [--mlock]
+//                            [--prefault <bytes>] [--load <threads>]
+// Linux only, real time priority and mlockall need the permissions listed in ThreadOptions.hpp.
+
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <depthai_bridge/ThreadOptions.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+int64_t monotonicNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<int64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+double percentileUs(const std::vector<int64_t>& sorted, double fraction) {
+    const size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()));
+    return sorted[index] / 1000.0;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int64_t periodUs = 1000;
+    int periods = 2000;
+    int loadThreads = 0;
+    dai::ros::ThreadOptions options;
+    for(int i = 1; i < argc; ++i) {
+        if(std::strcmp(argv[i], "--period-us") == 0 && i + 1 < argc) {
+            periodUs = std::max(10L, std::atol(argv[++i]));
+        } else if(std::strcmp(argv[i], "--periods") == 0 && i + 1 < argc) {
+            periods = std::max(1, std::atoi(argv[++i]));
+        } else if(std::strcmp(argv[i], "--fifo") == 0 && i + 1 < argc) {
+            options.fifoPriority = std::atoi(argv[++i]);
+        } else if(std::strcmp(argv[i], "--cpu") == 0 && i + 1 < argc) {
+            options.cpuAffinity.push_back(std::atoi(argv[++i]));
+        } else if(std::strcmp(argv[i], "--mlock") == 0) {
+            options.lockMemory = true;
+        } else if(std::strcmp(argv[i], "--prefault") == 0 && i + 1 < argc) {
+            options.prefaultStackBytes = std::strtoul(argv[++i], nullptr, 10);
+        } else if(std::strcmp(argv[i], "--load") == 0 && i + 1 < argc) {
+            loadThreads = std::max(0, std::atoi(argv[++i]));
+        } else {
+            std::fprintf(stderr,
+                         "usage: %s [--period-us <us>] [--periods <n>] [--fifo <priority>] [--cpu <n>]... [--mlock] [--prefault <bytes>] [--load <threads>]\n",
+                         argv[0]);
+            return 2;
+        }
+    }
+
+    std::atomic<bool> running(true);
+    std::vector<std::thread> load;
+    for(int i = 0; i < loadThreads; ++i) {
+        load.emplace_back([&running]() {
+            volatile uint64_t spin = 0;
+            while(running.load(std::memory_order_relaxed)) spin = spin + 1;
+        });
+    }
+
+    std::vector<int64_t> latencies;
+    latencies.reserve(periods);
+    bool applied = true;
+    std::thread measuring([&]() {
+        try {
+            dai::ros::applyThreadOptions(options);
+        } catch(const std::runtime_error& e) {
+            std::fprintf(stderr, "%s\n", e.what());
+            applied = false;
+            return;
+        }
+        // Absolute deadlines, so a late wake-up does not shift the ones after it
+        int64_t deadline = monotonicNs();
+        for(int i = 0; i < periods; ++i) {
+            deadline += periodUs * 1000;
+            timespec wakeup{static_cast<time_t>(deadline / 1000000000), static_cast<long>(deadline % 1000000000)};
+            while(clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeup, nullptr) != 0) {
+            }
+            latencies.push_back(monotonicNs() - deadline);
+        }
+    });
+    measuring.join();
+    running = false;
+    for(auto& thread : load) thread.join();
+    if(!applied) return 2;
+
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("%d periods of %lld us, %d load threads: wake-up latency p50 %.1f us, p99 %.1f us, max %.1f us\n",
+                periods,
+                static_cast<long long>(periodUs),
+                loadThreads,
+                percentileUs(latencies, 0.5),
+                percentileUs(latencies, 0.99),
+                latencies.back() / 1000.0);
+    return 0;
+}